@@ -59,14 +59,18 @@ int main() {
     // Helper::printInstanceGraphviz(landscape, plan, "aude.dot");
     // Helper::printInstance(landscape, plan, "aude.eps");
     
-    for(double B : budget_values) {
+    std::vector<Solution> pl_3_solutions =
+        pl_eca_3.solveBudgetSweep(landscape, plan, budget_values);
+
+    for(std::size_t k = 0; k < budget_values.size(); ++k) {
+        const double B = budget_values[k];
         const double base_ECA = eval(landscape);
         const double restored_ECA =
             eval(Helper::decore_landscape(landscape, plan));
         const double max_delta_ECA = restored_ECA - base_ECA;
 
         Solution pl_2_solution = pl_eca_2.solve(landscape, plan, B);
-        Solution pl_3_solution = pl_eca_3.solve(landscape, plan, B);
+        const Solution & pl_3_solution = pl_3_solutions[k];
 
         const double pl_2_ECA =
             eval(Helper::decore_landscape(landscape, plan, pl_2_solution));
@@ -55,8 +55,15 @@ int main() {
     // Helper::printInstance(landscape, plan, "quebec.eps");
 
     
-    for(double budget_percent : budget_percents) {
-        const double B = plan.totalCost() * budget_percent / 100;
+    std::vector<double> budgets;
+    for(double budget_percent : budget_percents)
+        budgets.push_back(plan.totalCost() * budget_percent / 100);
+    std::vector<Solution> pl_3_solutions =
+        pl_eca_3.solveBudgetSweep(landscape, plan, budgets);
+
+    for(std::size_t k = 0; k < budgets.size(); ++k) {
+        const double budget_percent = budget_percents[k];
+        const double B = budgets[k];
 
         const double base_ECA = eval(landscape);
         const double restored_ECA =
@@ -64,7 +71,7 @@ int main() {
         const double max_delta_ECA = restored_ECA - base_ECA;
 
         Solution pl_2_solution = pl_eca_2.solve(landscape, plan, B);
-        Solution pl_3_solution = pl_eca_3.solve(landscape, plan, B);
+        const Solution & pl_3_solution = pl_3_solutions[k];
 
         const double pl_2_ECA =
             eval(Helper::decore_landscape(landscape, plan, pl_2_solution));
@@ -24,6 +24,7 @@
 #include "solvers/pl_eca_2.hpp"
 #include "solvers/pl_eca_3.hpp"
 // #include "solvers/pl_eca_4.hpp"
+#include "solvers/portfolio.hpp"
 #include "solvers/randomized_rounding.hpp"
 
 #include "helper.hpp"
@@ -52,6 +53,14 @@ static std::vector<std::unique_ptr<concepts::Solver>> construct_solvers() {
     // solvers.emplace_back(std::make_unique<Solvers::PL_ECA_4>());
     solvers.emplace_back(std::make_unique<Solvers::Randomized_Rounding_ECA>());
 
+    auto rounding = std::make_unique<Solvers::Randomized_Rounding_ECA>();
+    rounding->setNbDraws(1000);
+    auto portfolio = std::make_unique<Solvers::Portfolio>();
+    portfolio->add(std::make_unique<Solvers::Glutton_ECA_Inc>())
+        .add(std::move(rounding))
+        .add(std::make_unique<Solvers::PL_ECA_3>());
+    solvers.emplace_back(std::move(portfolio));
+
     return solvers;
 }
 
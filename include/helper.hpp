@@ -323,6 +323,99 @@ DecoredLandscape<LS> decore_landscape(const LS & landscape,
     return decored_landscape;
 }
 
+/**
+ * @brief Applies the options of **solution** to the landscape, only the
+ * elements of the options with a non zero coefficient being visited.
+ */
+template <typename LS>
+DecoredLandscape<LS> decore_landscape(const LS & landscape,
+                                      const CompiledRestorationPlan<LS> & plan,
+                                      const Solution & solution) {
+    const auto & nodeOptions = plan.getNodeOptionsMap();
+    const auto & arcOptions = plan.getArcOptionsMap();
+    DecoredLandscape<LS> decored_landscape(landscape);
+    for(const typename CompiledRestorationPlan<LS>::Option i : plan.options()) {
+        if(solution[i] == 0) continue;
+        decored_landscape.apply(nodeOptions[i], arcOptions[i], solution[i]);
+    }
+    return decored_landscape;
+}
+
+template <typename LS>
+DecoredLandscape<LS> decore_landscape(
+    const LS & landscape, const CompiledRestorationPlan<LS> & plan) {
+    const auto & nodeOptions = plan.getNodeOptionsMap();
+    const auto & arcOptions = plan.getArcOptionsMap();
+    DecoredLandscape<LS> decored_landscape(landscape);
+    for(const typename CompiledRestorationPlan<LS>::Option i : plan.options())
+        decored_landscape.apply(nodeOptions[i], arcOptions[i]);
+    return decored_landscape;
+}
+
+/**
+ * @brief Applies the options of **options** to **decored_landscape**, that is
+ * expected to have its original weights, only their elements being visited.
+ * @time \f$O(\#elements(options))\f$
+ */
+template <typename LS>
+void decore_landscape(
+    DecoredLandscape<LS> & decored_landscape,
+    const CompiledRestorationPlan<LS> & plan,
+    const std::vector<typename CompiledRestorationPlan<LS>::Option> &
+        options) {
+    const auto & nodeOptions = plan.getNodeOptionsMap();
+    const auto & arcOptions = plan.getArcOptionsMap();
+    for(const typename CompiledRestorationPlan<LS>::Option i : options)
+        decored_landscape.apply(nodeOptions[i], arcOptions[i]);
+}
+
+/**
+ * @brief Applies the options i such that **chosen[i]** to
+ * **decored_landscape**, that is expected to have its original weights.
+ * @time \f$O(\#options + \#elements(chosen))\f$
+ */
+template <typename LS>
+void decore_landscape(DecoredLandscape<LS> & decored_landscape,
+                      const CompiledRestorationPlan<LS> & plan,
+                      const std::vector<bool> & chosen) {
+    const auto & nodeOptions = plan.getNodeOptionsMap();
+    const auto & arcOptions = plan.getArcOptionsMap();
+    for(const typename CompiledRestorationPlan<LS>::Option i : plan.options())
+        if(chosen[i]) decored_landscape.apply(nodeOptions[i], arcOptions[i]);
+}
+
+/**
+ * @brief Resets the weights changed by the options of **options**, so that
+ * **decored_landscape** can be reused without a full reset.
+ * @time \f$O(\#elements(options))\f$
+ */
+template <typename LS>
+void undecore_landscape(
+    DecoredLandscape<LS> & decored_landscape,
+    const CompiledRestorationPlan<LS> & plan,
+    const std::vector<typename CompiledRestorationPlan<LS>::Option> &
+        options) {
+    const auto & nodeOptions = plan.getNodeOptionsMap();
+    const auto & arcOptions = plan.getArcOptionsMap();
+    for(const typename CompiledRestorationPlan<LS>::Option i : options)
+        decored_landscape.reset(nodeOptions[i], arcOptions[i]);
+}
+
+/**
+ * @brief Resets the weights changed by the options i such that
+ * **chosen[i]**.
+ * @time \f$O(\#options + \#elements(chosen))\f$
+ */
+template <typename LS>
+void undecore_landscape(DecoredLandscape<LS> & decored_landscape,
+                        const CompiledRestorationPlan<LS> & plan,
+                        const std::vector<bool> & chosen) {
+    const auto & nodeOptions = plan.getNodeOptionsMap();
+    const auto & arcOptions = plan.getArcOptionsMap();
+    for(const typename CompiledRestorationPlan<LS>::Option i : plan.options())
+        if(chosen[i]) decored_landscape.reset(nodeOptions[i], arcOptions[i]);
+}
+
 void printSolution(const MutableLandscape & landscape,
                    const RestorationPlan<MutableLandscape> & plan,
                    std::string name, concepts::Solver & solver, double B,
@@ -428,4 +521,145 @@ double max_flow_in(const LS & landscape, const RestorationPlan<LS> & plan,
     return sum;
 }
 
+/**
+ * @brief Bounds the flow that can reach t when at most B is spent : the
+ * options costing more than B are ignored and the total quality gain is
+ * limited by the fractional knapsack of the option contributions to t.
+ *
+ * Equals max_flow_in(landscape, plan, t) for an infinite budget.
+ */
+template <typename LS>
+double max_flow_in(const LS & landscape, const RestorationPlan<LS> & plan,
+                   typename LS::Node t, const double B) {
+    using Graph = typename LS::Graph;
+    using ProbabilityMap = typename LS::ProbabilityMap;
+    using Reversed = lemon::ReverseDigraph<const Graph>;
+    using Option = typename RestorationPlan<LS>::Option;
+
+    const Graph & original_g = landscape.getNetwork();
+    Reversed reversed_g(original_g);
+    ProbabilityMap probabilities(original_g);
+
+    for(typename Graph::ArcIt b(original_g); b != lemon::INVALID; ++b) {
+        probabilities[b] = landscape.getProbability(b);
+        for(auto const & e : plan[b]) {
+            if(plan.getCost(e.option) > B) continue;
+            probabilities[b] =
+                std::max(probabilities[b], e.restored_probability);
+        }
+    }
+
+    lemon::MultiplicativeSimplerDijkstra<Reversed, ProbabilityMap> dijkstra(
+        reversed_g, probabilities);
+    double sum = 0;
+    std::vector<std::pair<Option, double>> contributions;
+    dijkstra.init(t);
+    while(!dijkstra.emptyQueue()) {
+        std::pair<typename Graph::Node, double> pair =
+            dijkstra.processNextNode();
+        typename Graph::Node v = pair.first;
+        const double p_tv = pair.second;
+        sum += landscape.getQuality(v) * p_tv;
+        for(auto const & e : plan[v]) {
+            if(plan.getCost(e.option) > B) continue;
+            contributions.emplace_back(e.option, e.quality_gain * p_tv);
+        }
+    }
+    // merge the contributions of each option
+    std::sort(contributions.begin(), contributions.end());
+    auto last = contributions.begin();
+    for(auto it = contributions.begin(); it != contributions.end(); ++it) {
+        if(last != it && last->first == it->first) {
+            last->second += it->second;
+            continue;
+        }
+        if(last != it) *(++last) = *it;
+    }
+    if(!contributions.empty()) contributions.erase(last + 1, contributions.end());
+    // fractional knapsack
+    std::sort(contributions.begin(), contributions.end(),
+              [&plan](const auto & p1, const auto & p2) {
+                  return p1.second * plan.getCost(p2.first) >
+                         p2.second * plan.getCost(p1.first);
+              });
+    double remaining = B;
+    for(const auto & [i, contribution] : contributions) {
+        const double cost = plan.getCost(i);
+        if(cost <= remaining) {
+            sum += contribution;
+            remaining -= cost;
+            continue;
+        }
+        sum += contribution * remaining / cost;
+        break;
+    }
+    return sum;
+}
+
+/**
+ * @brief Routes the flow of every node toward t along the maximum probability
+ * paths of the landscape decored by the options of solution.
+ *
+ * For every arc a of the maximum probability paths tree rooted at t,
+ * arc_flow(a, e, x) is called with x the flow leaving the source of a and e a
+ * pointer to the restoration element of a whose probability is used, nullptr
+ * if the original probability is used.
+ *
+ * @return the flow reaching t
+ */
+template <typename LS, typename F>
+double max_probability_tree_flow(const LS & landscape,
+                                 const RestorationPlan<LS> & plan,
+                                 const Solution & solution,
+                                 typename LS::Node t, F && arc_flow) {
+    using Graph = typename LS::Graph;
+    using Node = typename Graph::Node;
+    using Arc = typename Graph::Arc;
+    using ProbabilityMap = typename LS::ProbabilityMap;
+    using Reversed = lemon::ReverseDigraph<const Graph>;
+    using ArcRestorationElement =
+        typename RestorationPlan<LS>::ArcRestorationElement;
+
+    const Graph & original_g = landscape.getNetwork();
+    Reversed reversed_g(original_g);
+    ProbabilityMap probabilities(original_g);
+    typename Graph::template ArcMap<const ArcRestorationElement *>
+        used_elements(original_g, nullptr);
+
+    for(typename Graph::ArcIt b(original_g); b != lemon::INVALID; ++b) {
+        probabilities[b] = landscape.getProbability(b);
+        for(auto const & e : plan[b]) {
+            if(!solution.contains(e.option) ||
+               e.restored_probability <= probabilities[b])
+                continue;
+            probabilities[b] = e.restored_probability;
+            used_elements[b] = &e;
+        }
+    }
+
+    lemon::MultiplicativeDijkstra<Reversed, ProbabilityMap> dijkstra(
+        reversed_g, probabilities);
+    std::vector<Node> settled_nodes;
+    dijkstra.init();
+    dijkstra.addSource(t);
+    while(!dijkstra.emptyQueue())
+        settled_nodes.push_back(dijkstra.processNextNode());
+
+    typename Graph::template NodeMap<double> out_flow(original_g);
+    for(Node v : settled_nodes) {
+        out_flow[v] = landscape.getQuality(v);
+        for(auto const & e : plan[v])
+            out_flow[v] += solution[e.option] * e.quality_gain;
+    }
+    // the farthest nodes first : the flow of the subtree of v is complete
+    for(auto it = settled_nodes.rbegin(); it != settled_nodes.rend(); ++it) {
+        const Node v = *it;
+        if(v == t) break;
+        const Arc a = dijkstra.predArc(v);
+        arc_flow(a, used_elements[a], out_flow[v]);
+        out_flow[original_g.target(a)] += probabilities[a] * out_flow[v];
+    }
+    return out_flow[t];
+}
+
 #endif  // HELPER
\ No newline at end of file
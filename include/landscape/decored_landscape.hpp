@@ -121,16 +121,30 @@ public:
             setProbability(a, original_probabilityMap.get()[a]);
     }
 
-    void apply(
-        const typename RestorationPlan<LS>::NodeEnhancements & nodeEnhancements,
-        const double coef = 1.0) {
+    /**
+     * @brief Resets the weights of the given nodes and arcs to their original
+     * ones.
+     */
+    void reset(const typename CompiledRestorationPlan<LS>::NodeEnhancements &
+                   nodeEnhancements,
+               const typename CompiledRestorationPlan<LS>::ArcEnhancements &
+                   arcEnhancements) {
         for(const auto & [u, quality_gain] : nodeEnhancements)
-            qualityMap[u] += coef * quality_gain;
+            setQuality(u, original_qualityMap.get()[u]);
+        for(const auto & [a, restored_probability] : arcEnhancements)
+            setProbability(a, original_probabilityMap.get()[a]);
     }
 
-    void apply(
-        const typename RestorationPlan<LS>::ArcEnhancements & arcEnhancements,
-        const double coef = 1.0) {
+private:
+    template <typename NodeEnhancements>
+    void applyQualityGains(const NodeEnhancements & nodeEnhancements,
+                           const double coef) {
+        for(const auto & [u, quality_gain] : nodeEnhancements)
+            qualityMap[u] += coef * quality_gain;
+    }
+    template <typename ArcEnhancements>
+    void applyRestoredProbabilities(const ArcEnhancements & arcEnhancements,
+                                    const double coef) {
         for(const auto & [a, restored_probability] : arcEnhancements) {
             probabilityMap[a] =
                 std::max(probabilityMap[a],
@@ -140,6 +154,19 @@ public:
         }
     }
 
+public:
+    void apply(
+        const typename RestorationPlan<LS>::NodeEnhancements & nodeEnhancements,
+        const double coef = 1.0) {
+        applyQualityGains(nodeEnhancements, coef);
+    }
+
+    void apply(
+        const typename RestorationPlan<LS>::ArcEnhancements & arcEnhancements,
+        const double coef = 1.0) {
+        applyRestoredProbabilities(arcEnhancements, coef);
+    }
+
     void apply(
         const typename RestorationPlan<LS>::NodeEnhancements & nodeEnhancements,
         const typename RestorationPlan<LS>::ArcEnhancements & arcEnhancements,
@@ -147,6 +174,27 @@ public:
         apply(nodeEnhancements, coef);
         apply(arcEnhancements, coef);
     }
+
+    void apply(const typename CompiledRestorationPlan<LS>::NodeEnhancements &
+                   nodeEnhancements,
+               const double coef = 1.0) {
+        applyQualityGains(nodeEnhancements, coef);
+    }
+
+    void apply(const typename CompiledRestorationPlan<LS>::ArcEnhancements &
+                   arcEnhancements,
+               const double coef = 1.0) {
+        applyRestoredProbabilities(arcEnhancements, coef);
+    }
+
+    void apply(const typename CompiledRestorationPlan<LS>::NodeEnhancements &
+                   nodeEnhancements,
+               const typename CompiledRestorationPlan<LS>::ArcEnhancements &
+                   arcEnhancements,
+               const double coef = 1.0) {
+        apply(nodeEnhancements, coef);
+        apply(arcEnhancements, coef);
+    }
 };
 
 #endif  // DECORED_LANDSCAPE_HPP
\ No newline at end of file
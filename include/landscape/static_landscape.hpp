@@ -58,6 +58,20 @@ public:
         }
     }
 
+    /**
+     * @brief Builds the network with \p nb_nodes nodes and the arcs given as
+     * (source id, target id) pairs, sorted by source. The i-th arc gets id i.
+     * Qualities, coordinates and probabilities have to be set afterwards.
+     */
+    template <typename ArcListIterator>
+    void build(int nb_nodes, ArcListIterator first, ArcListIterator last) {
+        network.build(nb_nodes, first, last);
+    }
+
+    void setQuality(Node u, double quality);
+    void setCoords(Node u, Point coords);
+    void setProbability(Arc a, double probability);
+
     const Graph & getNetwork() const;
     const QualityMap & getQualityMap() const;
     const CoordsMap & getCoordsMap() const;
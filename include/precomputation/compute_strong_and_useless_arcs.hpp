@@ -3,49 +3,163 @@
 
 #include <algorithm>
 #include <atomic>
-#include <execution>
-#include <memory>
+#include <numeric>
+#include <queue>
 #include <thread>
-
-#include <tbb/concurrent_queue.h>
-#include <tbb/concurrent_vector.h>
+#include <utility>
+#include <vector>
 
 #include "algorithms/identify_strong_arcs.h"
 
-#include "helper.hpp"
+/**
+ * @brief Arcs labelled for each target, stored contiguously by target node id.
+ *
+ * The classification workers append (target id, arc) pairs to their own
+ * buffer, which are then gathered by a parallel counting sort.
+ */
+template <typename GR>
+class TargetArcs {
+public:
+    using Arc = typename GR::Arc;
+    // (target node id, arc) pairs found by one worker
+    using Buffer = std::vector<std::pair<int, Arc>>;
+
+    class Range {
+    private:
+        const Arc * _first;
+        const Arc * _last;
 
-template <typename Graph, typename LM,
-          typename TR = lemon::IdentifyDefaultTraits<Graph, LM>>
-auto compute_strong_and_useless_arcs(const Graph & graph,
-                                     const LM & lower_lengths,
-                                     const LM & upper_lengths) {
-    using Node = typename Graph::Node;
-    using NodeIt = typename Graph::NodeIt;
-    using NodeMap = typename Graph::NodeMap;
-    using Arc = typename Graph::Arc;
-    using ArcIt = typename Graph::ArcIt;
+    public:
+        Range(const Arc * first, const Arc * last)
+            : _first(first), _last(last) {}
+        const Arc * begin() const { return _first; }
+        const Arc * end() const { return _last; }
+        std::size_t size() const { return _last - _first; }
+    };
 
+private:
+    // arcs of the node of id u in [offsets[u], offsets[u+1])
+    std::vector<std::size_t> offsets;
     std::vector<Arc> arcs;
-    for(ArcIt b(graph); b != lemon::INVALID; ++b) arcs.push_back(b);
-    std::atomic<std::size_t> cpt_arc = 0;
 
-    NodeMap<bool> node_filter(graph, false);
-    for(Node u : target_nodes) node_filter[u] = true;
+    // calls f(begin, end) on nb_chunks consecutive parts of [0, n) in
+    // parallel
+    template <typename F>
+    static void parallel_chunks(std::size_t n, std::size_t nb_chunks, F && f) {
+        std::vector<std::thread> threads;
+        for(std::size_t k = 0; k < nb_chunks; ++k)
+            threads.emplace_back(
+                [&, k]() { f(n * k / nb_chunks, n * (k + 1) / nb_chunks); });
+        for(auto & thread : threads) thread.join();
+    }
+
+public:
+    TargetArcs() : offsets(1, 0) {}
+    /**
+     * @brief Gathers the buffers, which are released on the way.
+     */
+    TargetArcs(std::size_t nb_node_ids, std::vector<Buffer> buffers)
+        : offsets(nb_node_ids + 1, 0) {
+        const std::size_t nb_buffers = buffers.size();
+        if(nb_buffers == 0) return;
+        // number of arcs of the node u in the buffer k at
+        // [k * nb_node_ids + u], then the position of the first of them
+        std::vector<std::size_t> positions(nb_buffers * nb_node_ids, 0);
+        parallel_chunks(nb_buffers, nb_buffers, [&](std::size_t k,
+                                                    std::size_t) {
+            std::size_t * counts = positions.data() + k * nb_node_ids;
+            for(const auto & [u_id, a] : buffers[k]) ++counts[u_id];
+        });
+        parallel_chunks(nb_node_ids, nb_buffers,
+                        [&](std::size_t begin, std::size_t end) {
+                            for(std::size_t u_id = begin; u_id < end; ++u_id)
+                                for(std::size_t k = 0; k < nb_buffers; ++k)
+                                    offsets[u_id + 1] +=
+                                        positions[k * nb_node_ids + u_id];
+                        });
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        parallel_chunks(nb_node_ids, nb_buffers,
+                        [&](std::size_t begin, std::size_t end) {
+                            for(std::size_t u_id = begin; u_id < end; ++u_id) {
+                                std::size_t position = offsets[u_id];
+                                for(std::size_t k = 0; k < nb_buffers; ++k) {
+                                    std::size_t & count =
+                                        positions[k * nb_node_ids + u_id];
+                                    const std::size_t nb_arcs = count;
+                                    count = position;
+                                    position += nb_arcs;
+                                }
+                            }
+                        });
+        arcs.resize(offsets.back());
+        parallel_chunks(nb_buffers, nb_buffers, [&](std::size_t k,
+                                                    std::size_t) {
+            std::size_t * next = positions.data() + k * nb_node_ids;
+            for(const auto & [u_id, a] : buffers[k]) arcs[next[u_id]++] = a;
+            Buffer().swap(buffers[k]);
+        });
+    }
+
+    Range operator[](int u_id) const {
+        return Range(arcs.data() + offsets[u_id],
+                     arcs.data() + offsets[u_id + 1]);
+    }
+    std::size_t size() const { return arcs.size(); }
+};
+
+/**
+ * @brief How the strong and useless arcs are identified : one search per
+ * arc labelling the targets, one search per target labelling the arcs or
+ * the cheapest of them for the instance.
+ */
+enum class StrongUselessStrategy { AUTO, ARC_CENTRIC, TARGET_CENTRIC };
+
+/**
+ * @return the strategy run for nb_targets targets and nb_arcs candidate
+ * arcs, AUTO being resolved to ARC_CENTRIC or TARGET_CENTRIC
+ */
+inline StrongUselessStrategy resolve_strategy(StrongUselessStrategy strategy,
+                                              std::size_t nb_targets,
+                                              std::size_t nb_arcs) {
+    if(strategy != StrongUselessStrategy::AUTO) return strategy;
+    // an arc search stops as soon as no node can be labelled anymore while
+    // the two searches of a target visit all the nodes reaching it
+    return 16 * nb_targets < nb_arcs ? StrongUselessStrategy::TARGET_CENTRIC
+                                     : StrongUselessStrategy::ARC_CENTRIC;
+}
+
+namespace strong_useless_arcs_detail {
+inline std::size_t nb_workers(std::size_t nb_threads, std::size_t nb_jobs) {
+    if(nb_threads == 0)
+        nb_threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1, std::min(nb_threads, nb_jobs));
+}
+
+template <typename GR, typename LEN, typename TR>
+std::pair<TargetArcs<GR>, TargetArcs<GR>> arc_centric(
+    const GR & graph, const LEN & worst_lengths, const LEN & best_lengths,
+    const std::vector<typename GR::Node> & target_nodes,
+    const std::vector<typename GR::Arc> & arcs, std::size_t nb_threads) {
+    using Node = typename GR::Node;
+    using Arc = typename GR::Arc;
 
-    auto contractables_arcs =
-        std::make_unique<NodeMap<tbb::concurrent_vector<Arc>>>(graph);
-    auto deletables_arcs =
-        std::make_unique<NodeMap<tbb::concurrent_vector<Arc>>>(graph);
+    const std::size_t nb_node_ids = graph.maxNodeId() + 1;
+    std::vector<char> target_filter(nb_node_ids, false);
+    for(Node t : target_nodes) target_filter[graph.id(t)] = true;
 
+    nb_threads = nb_workers(nb_threads, arcs.size());
+    std::vector<typename TargetArcs<GR>::Buffer> strong_buffers(nb_threads);
+    std::vector<typename TargetArcs<GR>::Buffer> useless_buffers(nb_threads);
+    std::atomic<std::size_t> cpt_arc = 0;
     std::vector<std::thread> threads;
-    for(std::size_t i = 0; i < /*std::thread::hardware_concurrency()*/ 1; ++i) {
-        threads.emplace_back([&](void) {
+    for(std::size_t i = 0; i < nb_threads; ++i) {
+        threads.emplace_back([&, i](void) {
             std::vector<Node> strong_nodes;
             std::vector<Node> useless_nodes;
-            lemon::IdentifyStrong<Graph, LM, TR> identifyStrong(
-                graph, upper_lengths, lower_lengths);
-            lemon::IdentifyUseless<Graph, LM, TR> identifyUseless(
-                graph, upper_lengths, lower_lengths);
+            lemon::IdentifyStrong<GR, LEN, TR> identifyStrong(
+                graph, worst_lengths, best_lengths);
+            lemon::IdentifyUseless<GR, LEN, TR> identifyUseless(
+                graph, worst_lengths, best_lengths);
             identifyStrong.labeledNodesList(strong_nodes);
             identifyUseless.labeledNodesList(useless_nodes);
 
@@ -56,27 +170,220 @@ auto compute_strong_and_useless_arcs(const Graph & graph,
                 identifyStrong.run(a);
                 identifyUseless.run(a);
                 for(Node u : strong_nodes) {
-                    if(!node_filter[u]) continue;
-                    contractables_arcs[u].push_back(a);
+                    if(!target_filter[graph.id(u)]) continue;
+                    strong_buffers[i].emplace_back(graph.id(u), a);
                 }
                 for(Node u : useless_nodes) {
-                    if(!node_filter[u]) continue;
-                    deletables_arcs[u].push_back(a);
+                    if(!target_filter[graph.id(u)]) continue;
+                    useless_buffers[i].emplace_back(graph.id(u), a);
                 }
-                strong_nodes.clear();
-                useless_nodes.clear();
             }
         });
     }
     for(auto & thread : threads) thread.join();
 
-    return std::make_pair(contractables_arcs, deletables_arcs);
+    return std::make_pair(
+        TargetArcs<GR>(nb_node_ids, std::move(strong_buffers)),
+        TargetArcs<GR>(nb_node_ids, std::move(useless_buffers)));
 }
 
+// best path values from every node to t, the ids of the reached nodes being
+// flagged and appended to reached
+template <typename GR, typename LEN, typename OT>
+void reverse_search(const GR & graph, const LEN & lengths,
+                    typename GR::Node t,
+                    std::vector<typename OT::Value> & dist,
+                    std::vector<char> & flags, std::vector<int> & reached) {
+    using Node = typename GR::Node;
+    using InArcIt = typename GR::InArcIt;
+    using Value = typename OT::Value;
+    using Entry = std::pair<Value, Node>;
+    auto worse = [](const Entry & e1, const Entry & e2) {
+        return OT::less(e2.first, e1.first);
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(worse)> heap(
+        worse);
+    dist[graph.id(t)] = OT::zero();
+    flags[graph.id(t)] = true;
+    reached.push_back(graph.id(t));
+    heap.emplace(OT::zero(), t);
+    while(!heap.empty()) {
+        const auto [d, v] = heap.top();
+        heap.pop();
+        if(OT::less(dist[graph.id(v)], d)) continue;
+        for(InArcIt a(graph, v); a != lemon::INVALID; ++a) {
+            const Node u = graph.source(a);
+            const int u_id = graph.id(u);
+            const Value new_d = OT::plus(d, lengths[a]);
+            if(flags[u_id] && !OT::less(new_d, dist[u_id])) continue;
+            if(!flags[u_id]) {
+                flags[u_id] = true;
+                reached.push_back(u_id);
+            }
+            dist[u_id] = new_d;
+            heap.emplace(new_d, u);
+        }
+    }
+}
+
+// the two best values of the first arcs from a node
+template <typename GR, typename OT>
+class BestTwo {
+private:
+    using Arc = typename GR::Arc;
+    using Value = typename OT::Value;
+    int nb_values = 0;
+    Value first{}, second{};
+    Arc first_arc = lemon::INVALID;
+
+public:
+    void add(const Value & value, Arc a) {
+        if(nb_values == 0 || OT::less(value, first)) {
+            second = first;
+            first = value;
+            first_arc = a;
+        } else if(nb_values == 1 || OT::less(value, second))
+            second = value;
+        nb_values = std::min(nb_values + 1, 2);
+    }
+    // the best value of the arcs other than a, false if there is none
+    bool other(Arc a, Value & value) const {
+        if(nb_values == 0 || (a == first_arc && nb_values == 1)) return false;
+        value = (a == first_arc) ? second : first;
+        return true;
+    }
+};
+
+template <typename GR, typename LEN, typename TR>
+std::pair<TargetArcs<GR>, TargetArcs<GR>> target_centric(
+    const GR & graph, const LEN & worst_lengths, const LEN & best_lengths,
+    const std::vector<typename GR::Node> & target_nodes,
+    std::size_t nb_threads) {
+    using Node = typename GR::Node;
+    using Arc = typename GR::Arc;
+    using OutArcIt = typename GR::OutArcIt;
+    using OT = typename TR::OperationTraits;
+    using Value = typename OT::Value;
+
+    const std::size_t nb_node_ids = graph.maxNodeId() + 1;
+    nb_threads = nb_workers(nb_threads, target_nodes.size());
+    std::vector<typename TargetArcs<GR>::Buffer> strong_buffers(nb_threads);
+    std::vector<typename TargetArcs<GR>::Buffer> useless_buffers(nb_threads);
+    std::atomic<std::size_t> cpt_target = 0;
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < nb_threads; ++i) {
+        threads.emplace_back([&, i](void) {
+            std::vector<Value> d_worst(nb_node_ids), d_best(nb_node_ids);
+            std::vector<char> worst_flags(nb_node_ids, false);
+            std::vector<char> best_flags(nb_node_ids, false);
+            std::vector<int> worst_reached, reached;
+            for(std::size_t local_cpt{};
+                (local_cpt = cpt_target.fetch_add(
+                     1, std::memory_order_relaxed)) < target_nodes.size();) {
+                const Node t = target_nodes[local_cpt];
+                const int t_id = graph.id(t);
+                reverse_search<GR, LEN, OT>(graph, worst_lengths, t, d_worst,
+                                            worst_flags, worst_reached);
+                reverse_search<GR, LEN, OT>(graph, best_lengths, t, d_best,
+                                            best_flags, reached);
+
+                for(int u_id : reached) {
+                    const Node u = graph.nodeFromId(u_id);
+                    BestTwo<GR, OT> worst_firsts, best_firsts;
+                    for(OutArcIt a(graph, u); a != lemon::INVALID; ++a) {
+                        const int w_id = graph.id(graph.target(a));
+                        if(!best_flags[w_id]) continue;
+                        worst_firsts.add(
+                            OT::plus(worst_lengths[a], d_worst[w_id]), a);
+                        best_firsts.add(
+                            OT::plus(best_lengths[a], d_best[w_id]), a);
+                    }
+                    for(OutArcIt a(graph, u); a != lemon::INVALID; ++a) {
+                        const int v_id = graph.id(graph.target(a));
+                        if(!best_flags[v_id]) continue;
+                        // the empty path from t beats every cycle
+                        if(u_id == t_id) {
+                            useless_buffers[i].emplace_back(t_id, a);
+                            continue;
+                        }
+                        Value other_worst, other_best;
+                        // strict : with null cycles, the worst path from v
+                        // may come back through u and tie with the others
+                        if(!best_firsts.other(a, other_best) ||
+                           OT::less(OT::plus(worst_lengths[a], d_worst[v_id]),
+                                    other_best))
+                            strong_buffers[i].emplace_back(t_id, a);
+                        else if(worst_firsts.other(a, other_worst) &&
+                                OT::less(other_worst,
+                                         OT::plus(best_lengths[a],
+                                                  d_best[v_id])))
+                            useless_buffers[i].emplace_back(t_id, a);
+                    }
+                }
+
+                for(int u_id : worst_reached) worst_flags[u_id] = false;
+                for(int u_id : reached) best_flags[u_id] = false;
+                worst_reached.clear();
+                reached.clear();
+            }
+        });
+    }
+    for(auto & thread : threads) thread.join();
+
+    return std::make_pair(
+        TargetArcs<GR>(nb_node_ids, std::move(strong_buffers)),
+        TargetArcs<GR>(nb_node_ids, std::move(useless_buffers)));
+}
+}  // namespace strong_useless_arcs_detail
+
+/**
+ * @brief Computes, for each target, the arcs that are strong and useless for
+ * it : the arc uv is strong for t if, whatever the lengths between the worst
+ * and the best ones, a best path from u to t starts with uv, and useless if
+ * no best path from u to t starts with uv.
+ *
+ * TR gives the path algebra : lemon::IdentifyDefaultTraits for additive
+ * lengths, lemon::IdentifyMultiplicativeTraits for probabilities.
+ *
+ * The target-centric strategy labels a subset of the arcs labelled by the
+ * arc-centric one : it bounds the paths through uv by their worst value,
+ * even where they share arcs with the other paths, and does not label the
+ * ties as strong.
+ *
+ * @param arcs the candidate arcs for the arc-centric strategy, the arcs whose
+ * head can't reach a target may be omitted
+ * @param nb_threads number of workers, 0 for one per hardware thread
+ * @return the strong and the useless arcs of each target, by target node id
+ */
+template <typename GR, typename LEN,
+          typename TR = lemon::IdentifyDefaultTraits<GR, LEN>>
+std::pair<TargetArcs<GR>, TargetArcs<GR>> compute_strong_and_useless_arcs(
+    const GR & graph, const LEN & worst_lengths, const LEN & best_lengths,
+    const std::vector<typename GR::Node> & target_nodes,
+    const std::vector<typename GR::Arc> & arcs,
+    StrongUselessStrategy strategy = StrongUselessStrategy::AUTO,
+    std::size_t nb_threads = 0) {
+    if(resolve_strategy(strategy, target_nodes.size(), arcs.size()) ==
+       StrongUselessStrategy::TARGET_CENTRIC)
+        return strong_useless_arcs_detail::target_centric<GR, LEN, TR>(
+            graph, worst_lengths, best_lengths, target_nodes, nb_threads);
+    return strong_useless_arcs_detail::arc_centric<GR, LEN, TR>(
+        graph, worst_lengths, best_lengths, target_nodes, arcs, nb_threads);
+}
 
-template <typename LS>
-std::tuple<LS, RestorationPlan<LS>, typename LS::Node> contract_graph() {
-    
+template <typename GR, typename LEN,
+          typename TR = lemon::IdentifyDefaultTraits<GR, LEN>>
+std::pair<TargetArcs<GR>, TargetArcs<GR>> compute_strong_and_useless_arcs(
+    const GR & graph, const LEN & worst_lengths, const LEN & best_lengths,
+    const std::vector<typename GR::Node> & target_nodes,
+    StrongUselessStrategy strategy = StrongUselessStrategy::AUTO,
+    std::size_t nb_threads = 0) {
+    std::vector<typename GR::Arc> arcs;
+    for(typename GR::ArcIt a(graph); a != lemon::INVALID; ++a)
+        arcs.push_back(a);
+    return compute_strong_and_useless_arcs<GR, LEN, TR>(
+        graph, worst_lengths, best_lengths, target_nodes, arcs, strategy,
+        nb_threads);
 }
 
-#endif  // COMPUTE_STRONG_AND_USELESS_ARCS_HPP
\ No newline at end of file
+#endif  // COMPUTE_STRONG_AND_USELESS_ARCS_HPP
@@ -19,6 +19,10 @@ public:
     RestorationPlan<StaticLandscape> plan;
     StaticLandscape::Node t;
 
+    /**
+     * @brief An empty result, to be filled by \ref ContractionCache
+     */
+    ContractionResult() : plan(landscape) {}
     ContractionResult(const MutableLandscape & contracted_landscape,
                       const RestorationPlan<MutableLandscape> & contracted_plan,
                       MutableLandscape::Node contracted_t)
@@ -40,6 +44,8 @@ class ContractionPrecomputation {
 public:
     void remove_unconnected_nodes(MutableLandscape & landscape,
                                   MutableLandscape::Node t) const;
+    // any change of the output of contract_arc or contract_restorable_arc
+    // must bump CACHE_VERSION in contraction_cache.cpp
     void contract_arc(MutableLandscape & contracted_landscape,
                       RestorationPlan<MutableLandscape> & plan,
                       MutableLandscape::Arc a) const;
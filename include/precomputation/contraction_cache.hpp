@@ -0,0 +1,82 @@
+/**
+ * @file contraction_cache.hpp
+ * @brief ContractionCache class declaration
+ */
+#ifndef CONTRACTION_CACHE_HPP
+#define CONTRACTION_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "landscape/mutable_landscape.hpp"
+#include "solvers/concept/restoration_plan.hpp"
+
+#include "precomputation/compute_strong_and_useless_arcs.hpp"
+#include "precomputation/concept/contraction_precomputation.hpp"
+
+/**
+ * @brief On-disk cache of the per-target contracted instances.
+ *
+ * The contraction results of an instance are stored in one binary file named
+ * after a fingerprint of the landscape and the plan, so that solving the same
+ * instance again skips the contraction. Files are memory-mapped on load and
+ * written to a temporary file then renamed, so that concurrent processes never
+ * read a partial file.
+ *
+ * The directory is given by the LANDSCAPE_OPT_CACHE_DIR environment variable,
+ * an empty value disabling the cache, and defaults to
+ * <tmp>/landscape_opt_cache.
+ */
+class ContractionCache {
+public:
+    using ResultsMap =
+        MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>>;
+
+private:
+    std::filesystem::path directory;
+    bool enabled;
+
+public:
+    ContractionCache();
+    explicit ContractionCache(const std::filesystem::path & directory);
+
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Hash of everything the contraction depends on : node and arc
+     * ids, qualities, coordinates, probabilities, the restoration plan and
+     * the strong/useless arcs strategy, AUTO being resolved.
+     */
+    static std::uint64_t fingerprint(
+        const MutableLandscape & landscape,
+        const RestorationPlan<MutableLandscape> & plan,
+        const StrongUselessStrategy strategy);
+
+    std::filesystem::path path(std::uint64_t fingerprint) const;
+
+    /**
+     * @brief Loads the contraction results of the instance.
+     *
+     * @return the results of every target node or nullptr if the cache is
+     * disabled, has no valid file for the instance or misses a target
+     */
+    std::unique_ptr<ResultsMap> load(
+        const MutableLandscape & landscape,
+        const RestorationPlan<MutableLandscape> & plan,
+        const std::vector<MutableLandscape::Node> & target_nodes,
+        const StrongUselessStrategy strategy) const;
+
+    /**
+     * @brief Stores the contraction results of the target nodes, failures
+     * being silently ignored.
+     */
+    void store(const MutableLandscape & landscape,
+               const RestorationPlan<MutableLandscape> & plan,
+               const std::vector<MutableLandscape::Node> & target_nodes,
+               const StrongUselessStrategy strategy,
+               const ResultsMap & results) const;
+};
+
+#endif  // CONTRACTION_CACHE_HPP
@@ -2,47 +2,142 @@
 #define MY_CONTRACTION_ALGORITHM_HPP
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <execution>
 #include <memory>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
-#include <tbb/concurrent_queue.h>
-#include <tbb/concurrent_vector.h>
-
-#include "algorithms/identify_strong_arcs.h"
+#include "precomputation/compute_strong_and_useless_arcs.hpp"
 #include "precomputation/concept/contraction_precomputation.hpp"
 
 #include "helper.hpp"
 
 
+/**
+ * @brief Read-only CSR view of the in-arcs of a landscape graph, indexed by
+ * the node and arc ids, shared by the per-target contractions.
+ */
+class ContractionBase {
+public:
+    // in-arcs ids of the node of id u in [in_offsets[u], in_offsets[u+1])
+    std::vector<int> in_offsets;
+    std::vector<int> in_arcs;
+    // source node id of each arc id
+    std::vector<int> sources;
+
+    ContractionBase(const MutableLandscape::Graph & graph);
+};
+
+/**
+ * @brief Weights the contraction of each target depends on, indexed by the
+ * node and arc ids, used to find the targets affected by a change of the
+ * landscape or of the plan.
+ */
+class ContractionInputs {
+public:
+    int max_node_id;
+    // (source id, target id) of each arc id, (-1, -1) for the unused ids
+    std::vector<std::pair<int, int>> arcs;
+    std::vector<double> p_min;
+    // (option, restored probability) of each arc id
+    std::vector<std::vector<std::pair<int, double>>> arc_elements;
+    // quality, x and y of each node id
+    std::vector<std::array<double, 3>> node_weights;
+    // (option, quality gain) of each node id
+    std::vector<std::vector<std::pair<int, double>>> node_elements;
+    std::vector<double> costs;
+    // options having at least one element
+    std::vector<bool> used_options;
+
+    ContractionInputs(const MutableLandscape & landscape,
+                      const RestorationPlan<MutableLandscape> & plan);
+};
+
 class MyContractionAlgorithm : public ContractionPrecomputation {
 public:
+    using Strategy = StrongUselessStrategy;
+    using LabeledArcs = TargetArcs<MutableLandscape::Graph>;
+
+private:
+    // maximum number of targets contracted at once, 0 for one per hardware
+    // thread
+    std::size_t max_in_flight;
+    Strategy strategy;
+
+    /**
+     * @brief Builds in kept_landscape and kept_plan the subinstance of the
+     * nodes reaching t by the arcs whose ids are not in deleted_ids, found by
+     * a reverse search on base.
+     *
+     * Its cost only depends on the size of this subinstance, the references
+     * from the original ids are hashed.
+     *
+     * @param deleted_ids sorted ids of the useless arcs for t
+     * @return the node of t in kept_landscape
+     */
+    MutableLandscape::Node extract_kept_instance(
+        const MutableLandscape & landscape,
+        const RestorationPlan<MutableLandscape> & plan,
+        const ContractionBase & base, MutableLandscape::Node t,
+        const std::vector<int> & deleted_ids,
+        MutableLandscape & kept_landscape,
+        RestorationPlan<MutableLandscape> & kept_plan,
+        std::unordered_map<int, MutableLandscape::Arc> & arcsRef) const;
+
+    void contract_targets(
+        const MutableLandscape & landscape,
+        const RestorationPlan<MutableLandscape> & plan,
+        const ContractionBase & base,
+        const std::vector<MutableLandscape::Node> & target_nodes,
+        const LabeledArcs & contractables_arcs,
+        const LabeledArcs & deletables_arcs,
+        MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>> &
+            results) const;
+
+public:
+    MyContractionAlgorithm(std::size_t max_in_flight = 0,
+                           Strategy strategy = Strategy::AUTO)
+        : max_in_flight(max_in_flight), strategy(strategy) {}
+
+    Strategy getStrategy() const { return strategy; }
+
+    /**
+     * @brief Contracts the instance for orig_t, given its strong and useless
+     * arcs. Any change of its output must bump CACHE_VERSION in
+     * contraction_cache.cpp, the cached results being reloaded otherwise.
+     */
     template <typename ArcList>
     std::shared_ptr<ContractionResult> contract(
         const MutableLandscape & landscape,
         const RestorationPlan<MutableLandscape> & plan,
-        MutableLandscape::Node orig_t, ArcList & orig_contractables_arcs,
-        ArcList & orig_deletables_arcs) const {
+        const ContractionBase & base, MutableLandscape::Node orig_t,
+        const ArcList & orig_contractables_arcs,
+        const ArcList & orig_deletables_arcs) const {
         using Graph = MutableLandscape::Graph;
+        const Graph & graph = landscape.getNetwork();
+
+        std::vector<int> deleted_ids;
+        deleted_ids.reserve(orig_deletables_arcs.size());
+        for(Graph::Arc orig_a : orig_deletables_arcs)
+            deleted_ids.push_back(graph.id(orig_a));
+        std::sort(deleted_ids.begin(), deleted_ids.end());
 
+        // only the nodes reaching t without useless arc are copied
         MutableLandscape contracted_landscape;
-        auto refs = contracted_landscape.copy(landscape);
         RestorationPlan<MutableLandscape> contracted_plan(contracted_landscape);
-        Helper::copyPlan(contracted_plan, plan, *refs.first, *refs.second);
-        Graph::Node contracted_t = (*refs.first)[orig_t];
-
-        remove_unconnected_nodes(contracted_landscape, contracted_t);
+        std::unordered_map<int, Graph::Arc> arcsRef;
+        Graph::Node contracted_t = extract_kept_instance(
+            landscape, plan, base, orig_t, deleted_ids, contracted_landscape,
+            contracted_plan, arcsRef);
         const Graph & contracted_graph = contracted_landscape.getNetwork();
 
-        for(Graph::Arc orig_a : orig_deletables_arcs) {
-            Graph::Arc a = (*refs.second)[orig_a];
-            if(!contracted_graph.valid(a)) continue;
-            contracted_landscape.removeArc(a);
-        }
-
         for(Graph::Arc orig_a : orig_contractables_arcs) {
-            Graph::Arc a = (*refs.second)[orig_a];
+            auto it = arcsRef.find(graph.id(orig_a));
+            if(it == arcsRef.end()) continue;
+            Graph::Arc a = it->second;
             if(!contracted_graph.valid(a)) continue;
             if(contracted_plan.contains(a)) {
                 contract_restorable_arc(contracted_landscape, contracted_plan,
@@ -63,6 +158,28 @@ public:
     precompute(const MutableLandscape & landscape,
                const RestorationPlan<MutableLandscape> & plan,
                const std::vector<MutableLandscape::Node> & target_nodes) const;
+    /**
+     * @brief Incremental version of precompute, for an instance differing
+     * from the one of previous_inputs by its weights or its plan.
+     *
+     * Only the targets reachable from a changed node or arc are contracted
+     * again, from the arcs reaching them. The other results are copies of
+     * previous_results with the option costs updated. The options emptied
+     * since, as remove_options does, only lose their elements in these
+     * copies : the strong and useless arcs stay so when p_max decreases and
+     * the contracted elements of an option only derive from its own
+     * elements. Falls back to the full precomputation if the graph changed
+     * or the options were renumbered.
+     */
+    std::unique_ptr<
+        MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>>>
+    precompute(const MutableLandscape & landscape,
+               const RestorationPlan<MutableLandscape> & plan,
+               const std::vector<MutableLandscape::Node> & target_nodes,
+               const ContractionInputs & previous_inputs,
+               const MutableLandscape::Graph::NodeMap<
+                   std::shared_ptr<ContractionResult>> & previous_results)
+        const;
     std::unique_ptr<
         MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>>>
     precompute(const MutableLandscape & landscape,
@@ -0,0 +1,77 @@
+#ifndef OPTIONS_PRESOLVE_HPP
+#define OPTIONS_PRESOLVE_HPP
+
+#include <vector>
+
+#include "landscape/mutable_landscape.hpp"
+#include "solvers/concept/restoration_plan.hpp"
+
+/**
+ * Copy the options of **plan** into the empty plan **copy** that refers to
+ * the same landscape. The options keep their IDs.
+ *
+ * @time \f$O((|V| + |A|) * \#options)\f$
+ * @space \f$O((|V| + |A|) * \#options)\f$
+ */
+void copy_options(const RestorationPlan<MutableLandscape> & plan,
+                  RestorationPlan<MutableLandscape> & copy);
+
+/**
+ * Remove every element of the options **i** such that **removed[i]** is true.
+ * The options are kept, empty, so that the IDs of the others are unchanged.
+ *
+ * @time \f$O((|V| + |A|) * \#options)\f$
+ * @space \f$O(1)\f$
+ */
+void remove_options(RestorationPlan<MutableLandscape> & plan,
+                    const std::vector<bool> & removed);
+
+/**
+ * Empty the options costing more than the budget **B**, they cannot be part
+ * of a solution.
+ *
+ * @return the number of emptied options
+ * @time \f$O((|V| + |A|) * \#options)\f$
+ * @space \f$O(\#options)\f$
+ */
+int remove_over_budget_options(RestorationPlan<MutableLandscape> & plan,
+                               const double B);
+
+/**
+ * Empty the options dominated by another one : an option **i** that only
+ * restores arcs is dominated by **j** if **j** costs at most the cost of
+ * **i** and restores each arc of **i** at least as much. Since the restored
+ * probabilities of an arc are not cumulated, **i** is useless when **j** is
+ * purchased and can be replaced by **j** otherwise. Among identical options,
+ * the one of smallest ID is kept.
+ *
+ * The options that enhance nodes are never emptied because quality gains
+ * are cumulated.
+ *
+ * @return the number of emptied options
+ * @time \f$O(|A| * \#options^2)\f$
+ * @space \f$O((|V| + |A|) * \#options)\f$
+ */
+int remove_dominated_options(RestorationPlan<MutableLandscape> & plan);
+
+/**
+ * Reduced cost fixing of the options from the LP relaxation of a
+ * maximization problem of value **lp_bound**, where the options take the
+ * values **y_values** with reduced costs **reduced_costs**, in the objective
+ * sense. Every solution whose value exceeds **incumbent_value** satisfies
+ * the fixings.
+ *
+ * **fixed** is updated with 0 or 1 for the fixed options, the others are
+ * left unchanged.
+ *
+ * @return the number of options newly fixed
+ * @time \f$O(\#options)\f$
+ * @space \f$O(1)\f$
+ */
+int reduced_cost_fixing(const std::vector<double> & y_values,
+                        const std::vector<double> & reduced_costs,
+                        const double lp_bound, const double incumbent_value,
+                        std::vector<int> & fixed,
+                        const double epsilon = 1.0e-9);
+
+#endif  // OPTIONS_PRESOLVE_HPP
@@ -1,6 +1,12 @@
 #ifndef TRIVIAL_REFORMULATION_HPP
 #define TRIVIAL_REFORMULATION_HPP
 
+#include <algorithm>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "landscape/mutable_landscape.hpp"
 #include "solvers/concept/instance.hpp"
 #include "solvers/concept/restoration_plan.hpp"
@@ -52,6 +58,48 @@ void contract_patches_components(MutableLandscape & landscape,
 void aggregate_parallel_arcs(MutableLandscape & landscape,
                              RestorationPlan<MutableLandscape> & plan);
 
+/**
+ * Erase the restoration elements and the arcs uv that are dominated for every
+ * pair of nodes : an element restoring uv to probability r is useless if,
+ * without uv, there is a path from u to v of probability at least r in the
+ * worst scenario, and so is uv itself if this path is at least as good as uv
+ * in its best scenario. The options left empty are discarded by
+ * copy_and_compact_instance.
+ *
+ * The paths are searched by a Dijkstra stopped at the lowest probability of
+ * interest and that does not extend the paths of **max_hops** arcs, which
+ * bounds the search to the **max_hops** neighborhood of each arc. The longer
+ * dominating paths may be missed, leaving their arcs in place.
+ *
+ * @time \f$O(|A| * (|V| + |A|) * \log |A|)\f$
+ * @space \f$O(|V| + |A|)\f$
+ */
+void remove_dominated_arcs(MutableLandscape & landscape,
+                           RestorationPlan<MutableLandscape> & plan,
+                           const int max_hops = 4);
+
+/**
+ * Erase every node of null quality, that cannot be enhanced and has no in or
+ * no out arcs since it cannot relay flow.
+ *
+ * @time \f$O(|V| + |A|)\f$
+ * @space \f$O(1)\f$
+ */
+void remove_dead_end_nodes(MutableLandscape & landscape,
+                           RestorationPlan<MutableLandscape> & plan);
+
+/**
+ * Bypass the relay nodes, of null quality and not enhanceable, having at most
+ * two neighbors : each path x->u->y with x != y is replaced by an arc xy of
+ * the product probability. The nodes whose arcs pairs are restored by
+ * different options are kept since their product is not representable.
+ *
+ * @time \f$O((|V| + |A|) * \#options)\f$
+ * @space \f$O(1)\f$
+ */
+void contract_series_nodes(MutableLandscape & landscape,
+                           RestorationPlan<MutableLandscape> & plan);
+
 /**
  * Copy the instance passed in parameter and, doing so, compact it by removing
  * invalid nodes and arcs from **landscape** and empty options from **plan**.
@@ -72,6 +120,10 @@ Instance copy_and_compact_instance(const Instance & instance);
  * - contracting the strongly connected components formed by
  *      arcs of probability 1
  * - aggregating parallels arcs
+ * - erasing the globally dominated arcs and restoration elements
+ * - erasing the nodes that cannot relay flow
+ * - bypassing the relay nodes of the chains
+ * until none of them applies.
  *
  * @time \f$O((|V| + |A|) * \#options)\f$
  * @space \f$O((|V| + |A|) * \#options)\f$
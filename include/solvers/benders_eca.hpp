@@ -0,0 +1,54 @@
+#ifndef BENDERS_ECA_SOLVER_HPP
+#define BENDERS_ECA_SOLVER_HPP
+
+#include "indices/eca.hpp"
+#include "solvers/concept/solver.hpp"
+
+#include "utils/osi_builder.hpp"
+
+namespace Solvers {
+/**
+ * @brief Benders decomposition of the PL_ECA_3 formulation.
+ *
+ * The master problem keeps the option variables y and one value variable per
+ * target. For fixed y, the flow problems of the contracted instances of the
+ * targets are independent LPs : they are built and solved in parallel and
+ * return optimality cuts. Only the master problem and the subproblems in
+ * progress are held in memory.
+ */
+class Benders_ECA : public concepts::Solver {
+public:
+    Benders_ECA() {
+        params["log"] = new IntParam(0);
+        params["gap"] = new DoubleParam(1e-6);
+    }
+
+    Benders_ECA & setLogLevel(int log_level) {
+        params["log"]->set(log_level);
+        return *this;
+    }
+    /**
+     * @brief Sets the time limit in seconds, 0 for none.
+     */
+    Benders_ECA & setTimeout(int seconds) {
+        params["timeout"]->set(seconds);
+        return *this;
+    }
+    /**
+     * @brief Sets the relative gap between the master bound and the best
+     * solution under which the algorithm stops.
+     */
+    Benders_ECA & setGap(double gap) {
+        params["gap"]->set(gap);
+        return *this;
+    }
+
+    Solution solve(const MutableLandscape & landscape,
+                   const RestorationPlan<MutableLandscape> & plan,
+                   const double B) const;
+
+    const std::string name() const { return "benders_eca"; }
+};
+}  // namespace Solvers
+
+#endif  // BENDERS_ECA_SOLVER_HPP
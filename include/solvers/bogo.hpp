@@ -12,6 +12,11 @@ public:
         return *this;
     }
 
+    Bogo & setTimeout(int seconds) {
+        params["timeout"]->set(seconds);
+        return *this;
+    }
+
     Solution solve(const MutableLandscape & landscape,
                    const RestorationPlan<MutableLandscape> & plans,
                    const double B) const;
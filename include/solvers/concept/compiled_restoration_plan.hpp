@@ -0,0 +1,232 @@
+/**
+ * @file compiled_restoration_plan.hpp
+ * @brief CompiledRestorationPlan class declaration
+ */
+#ifndef COMPILED_RESTORATION_PLAN_HPP
+#define COMPILED_RESTORATION_PLAN_HPP
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "solvers/concept/restoration_plan.hpp"
+
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/subrange.hpp>
+
+/**
+ * @brief Compressed sparse rows : the elements of each row stored
+ * contiguously, row r ranging from offsets[r] to offsets[r+1].
+ */
+template <typename E>
+class CSRIndex {
+private:
+    std::vector<int> _offsets;
+    std::vector<E> _elements;
+
+public:
+    using Row = ranges::subrange<typename std::vector<E>::const_iterator>;
+
+    CSRIndex() : _offsets(1, 0) {}
+
+    /**
+     * @brief Builds the index from the (row, element) pairs by a counting
+     * sort, that preserves the order of the elements of a row.
+     * @time \f$O(\#rows + \#elements)\f$
+     * @space \f$O(\#rows + \#elements)\f$
+     */
+    CSRIndex(int nb_rows, const std::vector<std::pair<int, E>> & entries)
+        : _offsets(nb_rows + 1, 0) {
+        for(const auto & entry : entries) ++_offsets[entry.first + 1];
+        for(int r = 0; r < nb_rows; ++r) _offsets[r + 1] += _offsets[r];
+        std::vector<int> positions(_offsets.begin(), _offsets.end() - 1);
+        std::vector<int> order(entries.size());
+        for(int k = 0; k < static_cast<int>(entries.size()); ++k)
+            order[positions[entries[k].first]++] = k;
+        _elements.reserve(entries.size());
+        for(const int k : order) _elements.push_back(entries[k].second);
+    }
+
+    int size() const noexcept { return _offsets.size() - 1; }
+    int getNbElements() const noexcept { return _elements.size(); }
+    int offset(int r) const noexcept { return _offsets[r]; }
+    const E & element(int k) const noexcept { return _elements[k]; }
+
+    Row operator[](int r) const noexcept {
+        return Row(_elements.begin() + _offsets[r],
+                   _elements.begin() + _offsets[r + 1]);
+    }
+};
+
+/**
+ * @brief An immutable snapshot of a RestorationPlan indexed for the solvers.
+ *
+ * The restoration elements are numbered option by option, so that the
+ * elements of an option have consecutive ids and the ids only depend on the
+ * plan content. Both the option -> elements and the node/arc -> elements
+ * indexes are stored as CSR arrays and the elements counts are cached.
+ * The landscape and the plan must not be modified while it is used.
+ */
+template <typename LS>  // requires concepts::IsLandscape<LS> //c++20
+class CompiledRestorationPlan {
+public:
+    using Graph = typename LS::Graph;
+    using Node = typename LS::Node;
+    using Arc = typename LS::Arc;
+
+    using Option = typename RestorationPlan<LS>::Option;
+    using NodeRestorationElement =
+        typename RestorationPlan<LS>::NodeRestorationElement;
+    using ArcRestorationElement =
+        typename RestorationPlan<LS>::ArcRestorationElement;
+
+    using NodeOptionsMap = CSRIndex<std::pair<Node, double>>;
+    using ArcOptionsMap = CSRIndex<std::pair<Arc, double>>;
+    using NodeEnhancements = typename NodeOptionsMap::Row;
+    using ArcEnhancements = typename ArcOptionsMap::Row;
+    using NodeRestorationsList =
+        typename CSRIndex<NodeRestorationElement>::Row;
+    using ArcRestorationsList = typename CSRIndex<ArcRestorationElement>::Row;
+
+private:
+    const LS & _landscape;
+    std::vector<double> _costs;
+
+    NodeOptionsMap _nodeOptions;
+    ArcOptionsMap _arcOptions;
+    CSRIndex<NodeRestorationElement> _nodeElements;
+    CSRIndex<ArcRestorationElement> _arcElements;
+
+public:
+    /**
+     * @time \f$O(|V| + |A| + \#elements)\f$
+     * @space \f$O(|V| + |A| + \#elements)\f$
+     */
+    explicit CompiledRestorationPlan(const RestorationPlan<LS> & plan)
+        : _landscape(plan.getLandscape()) {
+        const Graph & graph = _landscape.getNetwork();
+        const int nb_options = plan.getNbOptions();
+        _costs.reserve(nb_options);
+        for(const Option i : plan.options()) _costs.push_back(plan.getCost(i));
+
+        std::vector<std::pair<int, std::pair<Node, double>>> node_entries;
+        for(typename Graph::NodeIt u(graph); u != lemon::INVALID; ++u)
+            for(const auto & e : plan[u])
+                node_entries.emplace_back(
+                    e.option, std::make_pair(Node(u), e.quality_gain));
+        _nodeOptions = NodeOptionsMap(nb_options, node_entries);
+
+        std::vector<std::pair<int, std::pair<Arc, double>>> arc_entries;
+        for(typename Graph::ArcIt a(graph); a != lemon::INVALID; ++a)
+            for(const auto & e : plan[a])
+                arc_entries.emplace_back(
+                    e.option, std::make_pair(Arc(a), e.restored_probability));
+        _arcOptions = ArcOptionsMap(nb_options, arc_entries);
+
+        // the element ids are the positions in the options index
+        std::vector<std::pair<int, NodeRestorationElement>> node_elements;
+        node_elements.reserve(_nodeOptions.getNbElements());
+        for(const Option i : options())
+            for(int k = _nodeOptions.offset(i); k < _nodeOptions.offset(i + 1);
+                ++k) {
+                const auto & [u, quality_gain] = _nodeOptions.element(k);
+                node_elements.emplace_back(
+                    graph.id(u), NodeRestorationElement(k, i, quality_gain));
+            }
+        _nodeElements = CSRIndex<NodeRestorationElement>(
+            graph.maxNodeId() + 1, node_elements);
+
+        std::vector<std::pair<int, ArcRestorationElement>> arc_elements;
+        arc_elements.reserve(_arcOptions.getNbElements());
+        for(const Option i : options())
+            for(int k = _arcOptions.offset(i); k < _arcOptions.offset(i + 1);
+                ++k) {
+                const auto & [a, restored_probability] = _arcOptions.element(k);
+                arc_elements.emplace_back(
+                    graph.id(a),
+                    ArcRestorationElement(k, i, restored_probability));
+            }
+        _arcElements = CSRIndex<ArcRestorationElement>(graph.maxArcId() + 1,
+                                                       arc_elements);
+    }
+
+    const LS & getLandscape() const noexcept { return _landscape; }
+
+    int getNbOptions() const noexcept { return _costs.size(); }
+    bool contains(Option i) const noexcept {
+        return i >= 0 && i < getNbOptions();
+    }
+    double getCost(Option i) const noexcept { return _costs[i]; }
+    double totalCost() const noexcept {
+        return std::accumulate(_costs.begin(), _costs.end(), 0.0);
+    }
+    auto options() const {
+        return ranges::iota_view<int, int>(0, getNbOptions());
+    }
+
+    /**
+     * @brief Get the number of restoration elements concerning nodes
+     * @time \f$O(1)\f$
+     * @space \f$O(1)\f$
+     */
+    int getNbNodeRestorationElements() const noexcept {
+        return _nodeOptions.getNbElements();
+    }
+    /**
+     * @brief Get the number of restoration elements concerning arcs
+     * @time \f$O(1)\f$
+     * @space \f$O(1)\f$
+     */
+    int getNbArcRestorationElements() const noexcept {
+        return _arcOptions.getNbElements();
+    }
+    int getNbElements() const noexcept {
+        return getNbNodeRestorationElements() + getNbArcRestorationElements();
+    }
+
+    /**
+     * @brief The (node, quality_gain) pairs of each option, the k-th pair of
+     * the index being the node element of id k.
+     */
+    const NodeOptionsMap & getNodeOptionsMap() const noexcept {
+        return _nodeOptions;
+    }
+    /**
+     * @brief The (arc, restored_probability) pairs of each option, the k-th
+     * pair of the index being the arc element of id k.
+     */
+    const ArcOptionsMap & getArcOptionsMap() const noexcept {
+        return _arcOptions;
+    }
+
+    bool contains(Node u) const noexcept {
+        return !_nodeElements[_landscape.getNetwork().id(u)].empty();
+    }
+    bool contains(Arc a) const noexcept {
+        return !_arcElements[_landscape.getNetwork().id(a)].empty();
+    }
+
+    /**
+     * @brief Returns the restoration elements concerning the node **u**
+     * @time \f$O(1)\f$
+     * @space \f$O(1)\f$
+     */
+    NodeRestorationsList operator[](Node u) const noexcept {
+        return _nodeElements[_landscape.getNetwork().id(u)];
+    }
+    /**
+     * @brief Returns the restoration elements concerning the arc **a**
+     * @time \f$O(1)\f$
+     * @space \f$O(1)\f$
+     */
+    ArcRestorationsList operator[](Arc a) const noexcept {
+        return _arcElements[_landscape.getNetwork().id(a)];
+    }
+};
+
+template <typename LS>
+CompiledRestorationPlan<LS> RestorationPlan<LS>::compile() const {
+    return CompiledRestorationPlan<LS>(*this);
+}
+
+#endif  // COMPILED_RESTORATION_PLAN_HPP
@@ -0,0 +1,75 @@
+#ifndef INCUMBENT_STORE_HPP
+#define INCUMBENT_STORE_HPP
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "solvers/concept/solution.hpp"
+
+/**
+ * @brief Best solution shared by concurrent solvers of the same instance.
+ *
+ * The solutions are compared by their ECA value, computed by the publisher.
+ * Closing the store tells the other solvers that the incumbent is optimal.
+ */
+class IncumbentStore {
+private:
+    mutable std::mutex mutex;
+    std::vector<double> best_coefs;
+    double best_value;
+    std::atomic<bool> closed;
+
+public:
+    IncumbentStore()
+        : best_value(-std::numeric_limits<double>::infinity()), closed(false) {}
+
+    /**
+     * @brief Stores solution if its value improves the incumbent.
+     *
+     * @return true if solution is the new incumbent
+     */
+    bool publish(const Solution & solution, const double value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(value <= best_value) return false;
+        best_value = value;
+        best_coefs = solution.getCoefs();
+        return true;
+    }
+
+    bool hasIncumbent() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !best_coefs.empty();
+    }
+    /**
+     * @return the ECA of the incumbent, -infinity if none
+     */
+    double getBestValue() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return best_value;
+    }
+    /**
+     * @return the option coefficients of the incumbent, empty if none
+     */
+    std::vector<double> getBestCoefs() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return best_coefs;
+    }
+
+    /**
+     * @return the ECA and the option coefficients of the incumbent, read
+     * together
+     */
+    std::pair<double, std::vector<double>> getBest() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::make_pair(best_value, best_coefs);
+    }
+
+    void close() { closed = true; }
+    bool isClosed() const { return closed; }
+    const std::atomic<bool> * getClosedFlag() const { return &closed; }
+};
+
+#endif  // INCUMBENT_STORE_HPP
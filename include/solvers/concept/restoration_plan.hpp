@@ -24,6 +24,9 @@
 #include <range/v3/view/iota.hpp>
 #include <range/v3/view/transform.hpp>
 
+template <typename LS>
+class CompiledRestorationPlan;
+
 /**
  * @brief A generic class for respresenting a landscape restoration plan.
  *
@@ -421,6 +424,15 @@ public:
         return arcOptionsMap;
     }
 
+    /**
+     * @brief Freezes the plan into CSR indexes of its restoration elements,
+     * to be used as long as the plan and the landscape are not modified.
+     * @return CompiledRestorationPlan<LS>
+     * @time \f$O(|V| + |A| + \#elements)\f$
+     * @space \f$O(|V| + |A| + \#elements)\f$
+     */
+    CompiledRestorationPlan<LS> compile() const;
+
     /**
      * @brief Returns the restoration options concerning the node **u**
      * @param u Node
@@ -490,4 +502,6 @@ public:
 template <typename LS>  // requires concepts::IsLandscape<LS> //c++20
 std::ostream & operator<<(std::ostream & in, const RestorationPlan<LS> & plan);
 
+#include "solvers/concept/compiled_restoration_plan.hpp"
+
 #endif  // RESTORATION_PLAN_HPP
\ No newline at end of file
@@ -8,11 +8,23 @@
 
 class Solution {
 public:
+    enum Status {
+        // the solver ran to completion without optimality proof
+        FEASIBLE = 0,
+        // the solution is proven optimal
+        OPTIMAL = 1,
+        // the deadline expired, the solution is the best found so far
+        TIMEOUT = 2
+    };
+
     int nb_vars;
     int nb_constraints;
     int nb_elems;
     int preprocessing_time;
     double obj;
+    // upper bound on obj proven by the solver, infinity if none
+    double bound;
+    Status status;
 
 private:
     // reference wrapper needed for default construct operations
@@ -26,7 +38,9 @@ private:
 public:
     Solution(const MutableLandscape & landscape,
              const RestorationPlan<MutableLandscape> & plan)
-        : landscape(landscape)
+        : bound(std::numeric_limits<double>::infinity())
+        , status(FEASIBLE)
+        , landscape(landscape)
         , plan(plan)
         , coefs(plan.getNbOptions(), 0.0)
         , compute_time_ms(0){};
@@ -12,10 +12,12 @@
 
 #include "landscape/mutable_landscape.hpp"
 
+#include "solvers/concept/incumbent_store.hpp"
 #include "solvers/concept/restoration_plan.hpp"
 #include "solvers/concept/solution.hpp"
 
 #include "utils/chrono.hpp"
+#include "utils/deadline.hpp"
 
 namespace concepts {
 class Solver {
@@ -64,8 +66,25 @@ protected:
     };
 
     std::map<std::string, Param *> params;
+    // not owned, shared with the concurrent solvers of a Portfolio
+    IncumbentStore * incumbent_store;
+
+    /**
+     * @brief The deadline of a solve starting now, given by the "timeout"
+     * parameter in seconds, unlimited if 0. It expires when the incumbent
+     * store is closed.
+     */
+    Deadline makeDeadline() const {
+        const int timeout = params.at("timeout")->getInt();
+        const std::atomic<bool> * stop =
+            incumbent_store ? incumbent_store->getClosedFlag() : nullptr;
+        return timeout > 0 ? Deadline(timeout, stop) : Deadline(stop);
+    }
 
 public:
+    Solver() : incumbent_store(nullptr) {
+        params["timeout"] = new IntParam(0);
+    }
     virtual ~Solver() {
         for(std::pair<std::string, Param *> element : params)
             delete element.second;
@@ -78,6 +97,11 @@ public:
     };
     const std::map<std::string, Param *> & getParams() const { return params; };
 
+    /**
+     * @brief Shares the incumbents with other solvers, nullptr to detach.
+     */
+    void setIncumbentStore(IncumbentStore * store) { incumbent_store = store; }
+
     virtual Solution solve(const MutableLandscape & landscape,
                            const RestorationPlan<MutableLandscape> & plan,
                            const double B) const = 0;
@@ -0,0 +1,58 @@
+#ifndef LAGRANGIAN_ECA_SOLVER_HPP
+#define LAGRANGIAN_ECA_SOLVER_HPP
+
+#include "indices/eca.hpp"
+#include "solvers/concept/solver.hpp"
+
+#include "utils/osi_builder.hpp"
+
+namespace Solvers {
+/**
+ * @brief Lagrangian relaxation of the PL_ECA_3 formulation.
+ *
+ * The option variables y are duplicated for each target on the options
+ * appearing in its contracted instance and the copy constraints are dualized.
+ * The per target MIPs are solved in parallel, the multipliers are updated by
+ * subgradient steps with Polyak step sizes and the per target choices are
+ * repaired into feasible solutions.
+ *
+ * The returned solution is the best repaired one, its bound field holds the
+ * best Lagrangian bound.
+ */
+class Lagrangian_ECA : public concepts::Solver {
+public:
+    Lagrangian_ECA() {
+        params["log"] = new IntParam(0);
+        params["iterations"] = new IntParam(100);
+        params["gap"] = new DoubleParam(1e-4);
+    }
+
+    Lagrangian_ECA & setLogLevel(int log_level) {
+        params["log"]->set(log_level);
+        return *this;
+    }
+    Lagrangian_ECA & setNbIterations(int nb_iterations) {
+        params["iterations"]->set(nb_iterations);
+        return *this;
+    }
+    /**
+     * @brief Sets the time limit in seconds, 0 for none.
+     */
+    Lagrangian_ECA & setTimeout(int seconds) {
+        params["timeout"]->set(seconds);
+        return *this;
+    }
+    Lagrangian_ECA & setGap(double gap) {
+        params["gap"]->set(gap);
+        return *this;
+    }
+
+    Solution solve(const MutableLandscape & landscape,
+                   const RestorationPlan<MutableLandscape> & plan,
+                   const double B) const;
+
+    const std::string name() const { return "lagrangian_eca"; }
+};
+}  // namespace Solvers
+
+#endif  // LAGRANGIAN_ECA_SOLVER_HPP
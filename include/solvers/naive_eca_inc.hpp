@@ -24,6 +24,11 @@ public:
         return *this;
     }
 
+    Naive_ECA_Inc & setTimeout(int seconds) {
+        params["timeout"]->set(seconds);
+        return *this;
+    }
+
     Solution solve(const MutableLandscape & landscape,
                    const RestorationPlan<MutableLandscape> & plan,
                    const double B) const;
@@ -24,7 +24,7 @@ class PL_ECA_Solver : public concepts::Solver {
             params["pieces"] = new IntParam(10);
             params["thresold"] = new DoubleParam(0.0);
             params["relaxed"] = new IntParam(0);
-            params["timeout"] = new IntParam(3600);
+            params["timeout"]->set(3600);
         }
 
         PL_ECA_Solver & setLogLevel(int log_level) {
@@ -4,6 +4,7 @@
 #include "indices/eca.hpp"
 #include "solvers/concept/solver.hpp"
 
+#include "utils/mip_backend.hpp"
 #include "utils/osi_builder.hpp"
 
 namespace Solvers {
@@ -12,7 +13,10 @@ public:
     PL_ECA_2() {
         params["log"] = new IntParam(0);
         params["relaxed"] = new IntParam(0);
-        params["timeout"] = new IntParam(0);
+        params["warm_start"] = new IntParam(0);
+        params["backend"] = new IntParam(MIPBackend::defaultType());
+        params["threads"] = new IntParam(8);
+        params["gap"] = new DoubleParam(1e-8);
     }
 
     PL_ECA_2 & setLogLevel(int log_level) {
@@ -27,6 +31,33 @@ public:
         params["timeout"]->set(fortest);
         return *this;
     }
+    /**
+     * @brief Sets the heuristic used to compute a MIP start, see
+     * Solvers::WarmStart::Heuristic, 0 for none.
+     */
+    PL_ECA_2 & setWarmStart(int heuristic) {
+        params["warm_start"]->set(heuristic);
+        return *this;
+    }
+
+    /**
+     * @brief Sets the MIP backend, see MIPBackend::Type.
+     */
+    PL_ECA_2 & setBackend(int backend) {
+        params["backend"]->set(backend);
+        return *this;
+    }
+    PL_ECA_2 & setThreads(int nb_threads) {
+        params["threads"]->set(nb_threads);
+        return *this;
+    }
+    /**
+     * @brief Sets the relative gap at which the MIP backend stops.
+     */
+    PL_ECA_2 & setGap(double gap) {
+        params["gap"]->set(gap);
+        return *this;
+    }
 
     Solution solve(const MutableLandscape & landscape,
                    const RestorationPlan<MutableLandscape> & options,
@@ -37,6 +68,23 @@ public:
     double eval(const MutableLandscape & landscape,
                 const RestorationPlan<MutableLandscape> & plan, const double B,
                 const Solution & solution) const;
+
+private:
+    /**
+     * @brief The backend parameters, the time limit being what remains
+     * before the deadline.
+     */
+    MIPBackend::Params backendParams(const Deadline & deadline) const {
+        MIPBackend::Params backend_params;
+        backend_params.log_level = params.at("log")->getInt();
+        if(!deadline.isUnlimited())
+            backend_params.time_limit =
+                std::max(1.0, deadline.remainingS());
+        backend_params.nb_threads = params.at("threads")->getInt();
+        backend_params.gap = params.at("gap")->getDouble();
+        backend_params.relaxed = params.at("relaxed")->getBool();
+        return backend_params;
+    }
 };
 }  // namespace Solvers
 
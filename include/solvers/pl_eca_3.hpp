@@ -2,19 +2,33 @@
 #define PL_ECA_3_SOLVER_HPP
 
 #include "indices/eca.hpp"
+#include "indices/parallel_eca.hpp"
 #include "solvers/concept/solver.hpp"
 
 #include "precomputation/my_contraction_algorithm.hpp"
+#include "precomputation/options_presolve.hpp"
+#include "utils/mip_backend.hpp"
 #include "utils/osi_builder.hpp"
 
 namespace Solvers {
+namespace PL_ECA_3_Vars {
+class PreprocessedDatas;
+}  // namespace PL_ECA_3_Vars
+
 class PL_ECA_3 : public concepts::Solver {
 public:
     PL_ECA_3() {
         params["log"] = new IntParam(0);
-        params["timeout"] = new IntParam(36000);
+        params["timeout"]->set(36000);
         params["relaxed"] = new IntParam(0);
         params["fortest"] = new IntParam(0);
+        params["warm_start"] = new IntParam(0);
+        params["lazy"] = new IntParam(0);
+        params["tight_M"] = new IntParam(1);
+        params["presolve"] = new IntParam(1);
+        params["backend"] = new IntParam(MIPBackend::defaultType());
+        params["threads"] = new IntParam(8);
+        params["gap"] = new DoubleParam(1e-8);
     }
 
     PL_ECA_3 & setLogLevel(int log_level) {
@@ -33,16 +47,158 @@ public:
         params["fortest"]->set(fortest);
         return *this;
     }
+    /**
+     * @brief Sets the heuristic used to compute a MIP start, see
+     * Solvers::WarmStart::Heuristic, 0 for none.
+     */
+    PL_ECA_3 & setWarmStart(int heuristic) {
+        params["warm_start"]->set(heuristic);
+        return *this;
+    }
+    /**
+     * @brief Enables the lazy mode of solve, see solveLazy, with the given
+     * number of initial targets, 0 to disable.
+     */
+    PL_ECA_3 & setLazy(int nb_initial_targets) {
+        params["lazy"]->set(nb_initial_targets);
+        return *this;
+    }
+    /**
+     * @brief Enables the tightening of the big-M bounds with the budget, see
+     * PL_ECA_3_Vars::PreprocessedDatas.
+     */
+    PL_ECA_3 & setTightM(bool tight_M) {
+        params["tight_M"]->set(tight_M);
+        return *this;
+    }
+    /**
+     * @brief Sets the presolve level of the options : 0 for none, 1 to remove
+     * the options costing more than the budget and the dominated ones, 2 to
+     * also fix options by their reduced costs in the LP relaxation.
+     */
+    PL_ECA_3 & setPresolve(int level) {
+        params["presolve"]->set(level);
+        return *this;
+    }
+
+    /**
+     * @brief Sets the MIP backend, see MIPBackend::Type.
+     */
+    PL_ECA_3 & setBackend(int backend) {
+        params["backend"]->set(backend);
+        return *this;
+    }
+    PL_ECA_3 & setThreads(int nb_threads) {
+        params["threads"]->set(nb_threads);
+        return *this;
+    }
+    /**
+     * @brief Sets the relative gap at which the MIP backend stops.
+     */
+    PL_ECA_3 & setGap(double gap) {
+        params["gap"]->set(gap);
+        return *this;
+    }
 
     Solution solve(const MutableLandscape & landscape,
                    const RestorationPlan<MutableLandscape> & plan,
                    const double B) const;
 
+    /**
+     * @brief Solves the problem by generating the flow blocks of the targets
+     * lazily.
+     *
+     * The model starts with the flow blocks of the "lazy" targets of highest
+     * value bound, the value of the other targets being bounded by the
+     * surrogate v_t(0) + sum_i y_i * (v_t(all) - v_t(0)) over the options i
+     * appearing in their contracted instance. The flow blocks of the targets
+     * whose surrogate overestimates their value at the current solution are
+     * added and the model is solved again, until no surrogate is violated.
+     */
+    Solution solveLazy(const MutableLandscape & landscape,
+                       const RestorationPlan<MutableLandscape> & plan,
+                       const double B) const;
+
+    /**
+     * @brief Solves the problem for each budget of budgets while building the
+     * model only once : the preprocessing and the model construction are
+     * shared, only the bound of the budget row changes between the solves and
+     * each solve is warm started with the previous incumbent.
+     *
+     * @return the solutions in the order of budgets, i.e. the ECA/budget
+     * Pareto curve
+     */
+    std::vector<Solution> solveBudgetSweep(
+        const MutableLandscape & landscape,
+        const RestorationPlan<MutableLandscape> & plan,
+        const std::vector<double> & budgets) const;
+
     const std::string name() const { return "pl_eca_3"; }
 
+    /**
+     * @brief Computes the objective value of solution.
+     *
+     * For an integral solution, the optimal flow to each target follows the
+     * maximum probability paths of the decored landscape, so the value is the
+     * squared ECA of the decored landscape and no LP is solved. Fractional
+     * solutions are evaluated with evalLP.
+     */
     double eval(const MutableLandscape & landscape,
                 const RestorationPlan<MutableLandscape> & plan, const double B,
                 const Solution & solution) const;
+
+    /**
+     * @brief Computes the objective value of solution by solving the LP of
+     * the model with the y variables fixed.
+     */
+    double evalLP(const MutableLandscape & landscape,
+                  const RestorationPlan<MutableLandscape> & plan,
+                  const double B, const Solution & solution) const;
+
+private:
+    /**
+     * @brief Contracts the instance for each target, logging the time spent.
+     */
+    std::unique_ptr<PL_ECA_3_Vars::PreprocessedDatas> preprocess(
+        const MutableLandscape & landscape,
+        const RestorationPlan<MutableLandscape> & plan, const double B,
+        int & preprocessing_time) const;
+
+    /**
+     * @brief Builds and solves the model, the options i such that
+     * fixed_options[i] is 0 or 1 being fixed to this value.
+     * The preprocessed datas may have been computed for a plan with more
+     * elements, as long as the options of the missing ones are fixed to 0.
+     */
+    Solution solveModel(const MutableLandscape & landscape,
+                        const RestorationPlan<MutableLandscape> & plan,
+                        const double B,
+                        const std::vector<int> & fixed_options,
+                        PL_ECA_3_Vars::PreprocessedDatas & preprocessed_datas,
+                        const int preprocessing_time,
+                        const Deadline & deadline) const;
+
+    /**
+     * @brief The backend parameters, the time limit being what remains
+     * before the deadline.
+     */
+    MIPBackend::Params backendParams(const Deadline & deadline) const {
+        MIPBackend::Params backend_params;
+        backend_params.log_level = params.at("log")->getInt();
+        if(!deadline.isUnlimited())
+            backend_params.time_limit =
+                std::max(1.0, deadline.remainingS());
+        backend_params.nb_threads = params.at("threads")->getInt();
+        backend_params.gap = params.at("gap")->getDouble();
+        backend_params.relaxed = params.at("relaxed")->getBool();
+        return backend_params;
+    }
+
+    double M_budget(const double B) const {
+        return params.at("tight_M")->getBool()
+                   ? B
+                   : std::numeric_limits<double>::infinity();
+    }
 };
 }  // namespace Solvers
 
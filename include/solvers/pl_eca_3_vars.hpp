@@ -0,0 +1,181 @@
+/**
+ * @file pl_eca_3_vars.hpp
+ * @author François Hamonic (francois.hamonic@gmail.com)
+ * @brief Variables and preprocessing of the PL_ECA_3 formulation, shared with
+ * the decomposition solvers
+ */
+#ifndef PL_ECA_3_VARS_HPP
+#define PL_ECA_3_VARS_HPP
+
+#include "solvers/concept/solver.hpp"
+
+#include "precomputation/contraction_cache.hpp"
+#include "precomputation/my_contraction_algorithm.hpp"
+#include "utils/osi_builder.hpp"
+
+namespace Solvers::PL_ECA_3_Vars {
+class PreprocessedDatas {
+public:
+    std::vector<MutableLandscape::Node> target_nodes;
+    std::unique_ptr<
+        MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>>>
+        contracted_instances;
+    MutableLandscape::Graph::NodeMap<StaticLandscape::Graph::NodeMap<double> *>
+        M_Maps_Map;
+
+    /**
+     * @brief Contracts the instance for each target and computes the big-M
+     * bounds, tightened for the budget B : options costing more than B are
+     * ignored and the quality gains are limited by a fractional knapsack.
+     * The contracted instances are read from the \ref ContractionCache when
+     * available and stored in it otherwise.
+     */
+    PreprocessedDatas(const MutableLandscape & landscape,
+                      const RestorationPlan<MutableLandscape> & plan,
+                      const double B = std::numeric_limits<double>::infinity())
+        : M_Maps_Map(landscape.getNetwork()) {
+        const MutableLandscape::Graph & graph = landscape.getNetwork();
+        // target_nodes
+        for(MutableLandscape::NodeIt u(graph); u != lemon::INVALID; ++u) {
+            if(landscape.getQuality(u) == 0 && !plan.contains(u)) continue;
+            target_nodes.push_back(u);
+        }
+        // contracted_instances
+        const ContractionCache cache;
+        MyContractionAlgorithm alg2;
+        contracted_instances = cache.load(landscape, plan, target_nodes,
+                                          alg2.getStrategy());
+        if(!contracted_instances) {
+            contracted_instances =
+                alg2.precompute(landscape, plan, target_nodes);
+            cache.store(landscape, plan, target_nodes, alg2.getStrategy(),
+                        *contracted_instances);
+        }
+        // element ids and M_Maps_Map
+        std::for_each(
+            std::execution::par, target_nodes.begin(), target_nodes.end(),
+            [&](MutableLandscape::Node t) {
+                ContractionResult & cr = *(*contracted_instances)[t];
+                cr.plan.initElementIDs();
+                const StaticLandscape & contracted_landscape = cr.landscape;
+                const StaticLandscape::Graph & contracted_graph =
+                    contracted_landscape.getNetwork();
+                const RestorationPlan<StaticLandscape> & contracted_plan =
+                    cr.plan;
+
+                M_Maps_Map[t] = new StaticLandscape::Graph::NodeMap<double>(
+                    contracted_graph);
+                StaticLandscape::Graph::NodeMap<double> & M_Map =
+                    *M_Maps_Map[t];
+                for(StaticLandscape::NodeIt v(contracted_graph);
+                    v != lemon::INVALID; ++v)
+                    M_Map[v] = max_flow_in(contracted_landscape,
+                                           contracted_plan, v, B);
+            });
+    }
+    ~PreprocessedDatas() {
+        for(MutableLandscape::Node v : target_nodes) delete M_Maps_Map[v];
+    }
+};
+
+class XVar : public OSI_Builder::VarType {
+private:
+    const ContractionResult & _cr;
+
+public:
+    XVar(const ContractionResult & cr)
+        : VarType(lemon::countArcs(cr.landscape.getNetwork())), _cr(cr) {}
+    int id(StaticLandscape::Arc a) const {
+        const int id = _cr.landscape.getNetwork().id(a);
+        assert(id >= 0 && id < _number);
+        return _offset + id;
+    }
+};
+class RestoredXVar : public OSI_Builder::VarType {
+public:
+    RestoredXVar(const ContractionResult & cr)
+        : VarType(cr.plan.getNbArcRestorationElements()) {}
+    int id(RestorationPlan<StaticLandscape>::ArcRestorationElement e) const {
+        assert(e.id >= 0 && e.id < _number);
+        return _offset + e.id;
+    }
+};
+class FVar : public OSI_Builder::VarType {
+public:
+    FVar() : VarType(1) {}
+    int id() const { return _offset; }
+};
+class RestoredFVar : public OSI_Builder::VarType {
+public:
+    RestoredFVar(const ContractionResult & cr)
+        : VarType(cr.plan.getNbNodeRestorationElements()) {}
+    int id(RestorationPlan<MutableLandscape>::NodeRestorationElement e) const {
+        assert(e.id >= 0 && e.id < _number);
+        return _offset + e.id;
+    }
+};
+class YVar : public OSI_Builder::VarType {
+public:
+    YVar(const RestorationPlan<MutableLandscape> & plan)
+        : VarType(plan.getNbOptions(), 0, 1, true) {}
+    int id(RestorationPlan<MutableLandscape>::Option option) const {
+        const int id = option;
+        assert(id >= 0 && id < _number);
+        return _offset + id;
+    }
+};
+
+class ContractedVars {
+public:
+    XVar x;
+    RestoredXVar restored_x;
+    FVar f;
+    RestoredFVar restored_f;
+    ContractedVars(const ContractionResult & cr)
+        : x(cr), restored_x(cr), f(), restored_f(cr){};
+};
+
+class Variables {
+public:
+    MutableLandscape::Graph::NodeMap<ContractedVars *> contracted;
+    YVar y;
+    const PreprocessedDatas & _pdatas;
+    Variables(const MutableLandscape & landscape,
+              const RestorationPlan<MutableLandscape> & plan,
+              PreprocessedDatas & pdatas)
+        : contracted(landscape.getNetwork(), nullptr)
+        , y(plan)
+        , _pdatas(pdatas) {
+        for(MutableLandscape::Node v : pdatas.target_nodes)
+            contracted[v] =
+                new ContractedVars(*(*pdatas.contracted_instances)[v]);
+    }
+    ~Variables() {
+        for(MutableLandscape::Node v : _pdatas.target_nodes)
+            delete contracted[v];
+    }
+    ContractedVars & operator[](MutableLandscape::Node t) const {
+        return *contracted[t];
+    }
+};
+
+/**
+ * @brief Sets the objective coefficients of the variables of target t and
+ * pushes the flow conservation and big-M rows of its contracted instance.
+ */
+void fill_target(OSI_Builder & solver_builder,
+                 const MutableLandscape & landscape,
+                 const RestorationPlan<MutableLandscape> & plan,
+                 MutableLandscape::Node t, const ContractedVars & cvars,
+                 const YVar & y, const PreprocessedDatas & pdatas);
+
+/**
+ * @brief Options appearing in the contracted instance of target t or in its
+ * node restoration elements, i.e. the options its flow depends on.
+ */
+std::vector<RestorationPlan<MutableLandscape>::Option> relevant_options(
+    const RestorationPlan<MutableLandscape> & plan, MutableLandscape::Node t,
+    const PreprocessedDatas & pdatas);
+}  // namespace Solvers::PL_ECA_3_Vars
+
+#endif  // PL_ECA_3_VARS_HPP
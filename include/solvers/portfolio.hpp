@@ -0,0 +1,72 @@
+#ifndef PORTFOLIO_SOLVER_HPP
+#define PORTFOLIO_SOLVER_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "solvers/concept/solver.hpp"
+
+#include "indices/eca.hpp"
+
+namespace Solvers {
+/**
+ * @brief Races a set of solvers on the same instance and returns the best
+ * solution found.
+ *
+ * The solvers run concurrently and publish their solutions in a shared
+ * IncumbentStore. PL_ECA_3 starts from the incumbent available when its model
+ * is built, uses it as cutoff and injects the newer ones during its search.
+ * The race ends when every solver returned, at the deadline or as
+ * soon as one of them proves optimality. The obj and bound of the returned
+ * solution are ECA values.
+ */
+class Portfolio : public concepts::Solver {
+private:
+    std::vector<std::unique_ptr<concepts::Solver>> solvers;
+
+public:
+    Portfolio() {
+        params["log"] = new IntParam(0);
+        params["threads"] =
+            new IntParam(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    Portfolio & setLogLevel(int log_level) {
+        params["log"]->set(log_level);
+        return *this;
+    }
+    /**
+     * @brief Sets the number of threads shared by the solvers : one for each
+     * solver without "threads" parameter, the others share the remaining.
+     */
+    Portfolio & setThreads(int nb_threads) {
+        params["threads"]->set(nb_threads);
+        return *this;
+    }
+    Portfolio & setTimeout(int seconds) {
+        params["timeout"]->set(seconds);
+        return *this;
+    }
+
+    /**
+     * @brief Adds a solver to the race, its "timeout", "threads" and
+     * "parallel" parameters being overriden by the portfolio ones during
+     * solve and restored after.
+     */
+    Portfolio & add(std::unique_ptr<concepts::Solver> solver) {
+        solvers.emplace_back(std::move(solver));
+        return *this;
+    }
+
+    Solution solve(const MutableLandscape & landscape,
+                   const RestorationPlan<MutableLandscape> & plan,
+                   const double B) const;
+
+    const std::string name() const { return "portfolio"; }
+};
+}  // namespace Solvers
+
+#endif  // PORTFOLIO_SOLVER_HPP
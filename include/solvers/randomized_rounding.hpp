@@ -31,6 +31,11 @@ public:
         return *this;
     }
 
+    Randomized_Rounding_ECA & setTimeout(int seconds) {
+        params["timeout"]->set(seconds);
+        return *this;
+    }
+
     Solution solve(const MutableLandscape & landscape,
                    const RestorationPlan<MutableLandscape> & plans,
                    const double B) const;
@@ -0,0 +1,23 @@
+#ifndef WARM_START_HPP
+#define WARM_START_HPP
+
+#include "solvers/concept/solver.hpp"
+
+namespace Solvers::WarmStart {
+/**
+ * @brief Heuristics providing the MIP start of the PL solvers, selected by
+ * their "warm_start" param.
+ */
+enum Heuristic { NONE = 0, GLUTTON_ECA_INC = 1, NAIVE_ECA_INC = 2 };
+
+/**
+ * @brief Runs the given heuristic.
+ *
+ * @return the heuristic solution, the empty solution for NONE
+ */
+Solution compute(int heuristic, const MutableLandscape & landscape,
+                 const RestorationPlan<MutableLandscape> & plan,
+                 const double B, const int log_level = 0);
+}  // namespace Solvers::WarmStart
+
+#endif  // WARM_START_HPP
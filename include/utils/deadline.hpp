@@ -0,0 +1,61 @@
+/**
+ * @file deadline.hpp
+ * @brief Deadline class declaration
+ */
+#ifndef DEADLINE_HPP
+#define DEADLINE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+/**
+ * @brief A wall-clock deadline, checked cooperatively by the solvers.
+ *
+ * It also expires as soon as the optional stop flag is raised.
+ */
+class Deadline {
+private:
+    std::chrono::time_point<std::chrono::steady_clock> end_time;
+    bool unlimited;
+    const std::atomic<bool> * stop;
+
+public:
+    /**
+     * @brief A deadline that only expires with the stop flag
+     */
+    explicit Deadline(const std::atomic<bool> * stop = nullptr)
+        : end_time(), unlimited(true), stop(stop) {}
+    /**
+     * @brief A deadline expiring in the given number of seconds from now
+     */
+    explicit Deadline(double seconds, const std::atomic<bool> * stop = nullptr)
+        : end_time(std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                       std::chrono::duration<double>(seconds)))
+        , unlimited(false)
+        , stop(stop) {}
+
+    /**
+     * @return true if the deadline has no time limit
+     */
+    bool isUnlimited() const { return unlimited; }
+
+    bool expired() const {
+        if(stop != nullptr && *stop) return true;
+        return !unlimited && std::chrono::steady_clock::now() >= end_time;
+    }
+
+    /**
+     * @return the remaining seconds, 0 if expired and infinity if unlimited
+     */
+    double remainingS() const {
+        if(unlimited) return std::numeric_limits<double>::infinity();
+        const std::chrono::duration<double> remaining =
+            end_time - std::chrono::steady_clock::now();
+        return std::max(0.0, remaining.count());
+    }
+};
+
+#endif  // DEADLINE_HPP
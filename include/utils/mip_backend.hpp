@@ -0,0 +1,123 @@
+/**
+ * @file mip_backend.hpp
+ * @brief MIPBackend interface declaration
+ *
+ * The MIP solvers are selected at runtime : CBC/CLP is always available,
+ * Gurobi when the library is compiled WITH_GUROBI.
+ */
+#ifndef MIP_BACKEND_HPP
+#define MIP_BACKEND_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/osi_builder.hpp"
+
+namespace MIPBackend {
+enum Type { CBC = 0, GUROBI = 1 };
+
+/**
+ * @brief The parameters mapped onto each backend.
+ */
+struct Params {
+    int log_level = 0;
+    // seconds, 0 for none
+    double time_limit = 0;
+    int nb_threads = 8;
+    // relative gap
+    double gap = 1e-8;
+    // ignores the integrality constraints
+    bool relaxed = false;
+};
+
+/**
+ * @brief Called during the search, fills values with a solution to inject,
+ * a value for each column, and returns true if there is a new one.
+ */
+using IncumbentPoll = std::function<bool(std::vector<double> & values)>;
+
+/**
+ * @brief Solves the model of an OSI_Builder.
+ */
+class Backend {
+protected:
+    Params _params;
+    bool _has_cutoff;
+    double _cutoff;
+    IncumbentPoll _incumbent_poll;
+
+public:
+    Backend(const Params & params)
+        : _params(params), _has_cutoff(false), _cutoff(0) {}
+    virtual ~Backend() {}
+
+    virtual const std::string name() const = 0;
+
+    /**
+     * @brief Loads the model of solver_builder, that must outlive the backend.
+     */
+    virtual void load(OSI_Builder & solver_builder, int sense) = 0;
+    /**
+     * @brief Changes the upper bound of a row of the form expr <= ub, the
+     * rows with two finite bounds are not supported.
+     */
+    virtual void setRowUpper(int row_id, double ub) = 0;
+    /**
+     * @brief Sets the MIP start of the next solve, a value for each column.
+     */
+    virtual void setStart(const std::vector<double> & values) = 0;
+    /**
+     * @brief Discards the solutions of the next solve that do not improve
+     * value, e.g. the value of a solution found elsewhere.
+     */
+    void setCutoff(double value) {
+        _has_cutoff = true;
+        _cutoff = value;
+    }
+    /**
+     * @brief Polls incumbent_poll during the next solves, the solutions it
+     * returns being injected in the search if feasible.
+     */
+    void setIncumbentPoll(IncumbentPoll incumbent_poll) {
+        _incumbent_poll = std::move(incumbent_poll);
+    }
+    /**
+     * @brief Solves the loaded model.
+     *
+     * @return true if a solution has been found, none being found when the
+     * cutoff can't be improved
+     */
+    virtual bool solve() = 0;
+
+    /**
+     * @return true if the search completed : the solution is optimal or no
+     * solution improves the cutoff
+     */
+    virtual bool isProvenOptimal() const = 0;
+    virtual double getObjValue() const = 0;
+    /**
+     * @brief The best bound proven on the objective.
+     */
+    virtual double getBestBound() const = 0;
+    virtual const std::vector<double> & getSolution() const = 0;
+};
+
+/**
+ * @return true if the backend type has been compiled
+ */
+bool isAvailable(int type);
+
+/**
+ * @return GUROBI if available, CBC otherwise
+ */
+int defaultType();
+
+/**
+ * @brief Creates a backend of the given type, CBC if it is not available.
+ */
+std::unique_ptr<Backend> create(int type, const Params & params);
+}  // namespace MIPBackend
+
+#endif  // MIP_BACKEND_HPP
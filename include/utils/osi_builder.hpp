@@ -10,8 +10,10 @@
 #ifndef OSI_BUILDER_HPP
 #define OSI_BUILDER_HPP
 
+#include <algorithm>
 #include <functional>
 #include <numeric>
+#include <string>
 #include <vector>
 
 #include "OsiClpSolverInterface.hpp"
@@ -38,6 +40,7 @@ public:
         double _default_lb;
         double _default_ub;
         bool _integer;
+        std::string _name;
         VarType(int number, double lb = 0, double ub = INFTY,
                 bool integer = false)
             : _number(number)
@@ -48,6 +51,16 @@ public:
         VarType() : VarType(0) {}
 
     public:
+        /**
+         * @brief Sets the prefix of the names of the columns in the files
+         * written by writeLp and writeMps, the i-th column being named
+         * prefix + i.
+         */
+        VarType & setName(std::string name) {
+            _name = std::move(name);
+            return *this;
+        }
+        const std::string & getName() const { return _name; }
         void setOffset(int offset) { _offset = offset; }
         int getOffset() { return _offset; }
         int getNumber() const { return _number; }
@@ -102,11 +115,25 @@ public:
                             row_ub.data());
         solver->setObjSense(sense);
         if(relaxed) return solver;
-        for(int i : integers_variables) solver->setInteger(i);
+        for(int i : getIntegers()) solver->setInteger(i);
         solver->setColNames(colNames, 0, nb_vars, 0);
         return solver;
     }
 
+    /**
+     * @brief Writes the model in the LP format, directly from the row-major
+     * matrix. Column names are generated from the names of the VarTypes,
+     * rows are named r0, r1, ... The file is gzip compressed if its name ends
+     * with ".gz".
+     */
+    void writeLp(const std::string & file_name, int sense,
+                 bool relaxed = false) const;
+    /**
+     * @brief Writes the model in the free MPS format, see writeLp.
+     */
+    void writeMps(const std::string & file_name, int sense,
+                  bool relaxed = false) const;
+
     static int nb_pairs(int n) { return n * (n - 1) / 2; };
     static int nb_couples(int n) { return 2 * nb_pairs(n); };
 
@@ -131,6 +158,22 @@ public:
 
     const std::vector<VarType *> & getVarTypes() { return varTypes; }
 
+    /**
+     * @brief The integer columns, from setInteger and the integer VarTypes.
+     */
+    std::vector<int> getIntegers() const {
+        std::vector<int> integers(integers_variables);
+        for(VarType * varType : varTypes) {
+            if(!varType->isInteger()) continue;
+            for(int i = 0; i < varType->getNumber(); ++i)
+                integers.push_back(varType->getOffset() + i);
+        }
+        std::sort(integers.begin(), integers.end());
+        integers.erase(std::unique(integers.begin(), integers.end()),
+                       integers.end());
+        return integers;
+    }
+
     int getNbVars() const { return nb_vars; };
 
     int getNbNonZeroVars() const {
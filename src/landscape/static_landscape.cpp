@@ -5,6 +5,17 @@ StaticLandscape::StaticLandscape()
 
 StaticLandscape::~StaticLandscape() {}
 
+void StaticLandscape::setQuality(StaticLandscape::Node u, double quality) {
+    qualityMap[u] = quality;
+}
+void StaticLandscape::setCoords(StaticLandscape::Node u, Point coords) {
+    coordsMap[u] = coords;
+}
+void StaticLandscape::setProbability(StaticLandscape::Arc a,
+                                     double probability) {
+    probabilityMap[a] = probability;
+}
+
 const StaticLandscape::Graph & StaticLandscape::getNetwork() const {
     return network;
 }
@@ -1,5 +1,7 @@
 #include "precomputation/concept/contraction_precomputation.hpp"
 
+#include <algorithm>
+
 #include <lemon/dfs.h>
 
 /**
@@ -50,29 +52,44 @@ void ContractionPrecomputation::contract_arc(
     landscape.removeNode(u);
 }
 
-// static bool restorable_arc_is_contractable(
-//     const MutableLandscape & landscape,
-//     const RestorationPlan<MutableLandscape> & plan, MutableLandscape::Arc a) {
-//     const MutableLandscape::Graph & graph = landscape.getNetwork();
-//     if(plan[a].size() > 1) return false;
-//     RestorationPlan<MutableLandscape>::Option a_option =
-//         plan[a].begin()->option;
-//     MutableLandscape::Node u = graph.source(a);
-
-//     for(MutableLandscape::Graph::InArcIt b(graph, u); b != lemon::INVALID;
-//         ++b) {
-//         if(plan[b].size() != 1) return false;
-//         if(plan[b].begin()->option != a_option) return false;
-//     }
-//     if(!plan.contains(u)) return true;
-//     return plan[u].begin()->option == a_option || plan[u].size() == 1;
-// }
-
 /**
- * Contracts specified uv arc preserving graph ids
+ * Tests if the restorable arc uv, the only out-arc of u, can be contracted
+ * without losing the linearity of the plan : a single option i restoring uv
+ * composes with the in-arcs and the quality of u restored by i only, several
+ * options only compose with constant factors, i.e. the transit node u.
  *
  * @time \f$O(deg(u))\f$
- * @space \f$O(deg(u))\f$
+ * @space \f$O(1)\f$
+ */
+static bool restorable_arc_is_contractable(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, MutableLandscape::Arc a) {
+    const MutableLandscape::Graph & graph = landscape.getNetwork();
+    MutableLandscape::Node u = graph.source(a);
+    if(plan[a].size() == 1) {
+        const RestorationPlan<MutableLandscape>::Option a_option =
+            plan[a].begin()->option;
+        for(MutableLandscape::Graph::InArcIt b(graph, u); b != lemon::INVALID;
+            ++b)
+            for(const auto & e : plan[b])
+                if(e.option != a_option) return false;
+        for(const auto & e : plan[u])
+            if(e.option != a_option) return false;
+        return true;
+    }
+    if(landscape.getQuality(u) != 0 || plan.contains(u)) return false;
+    for(MutableLandscape::Graph::InArcIt b(graph, u); b != lemon::INVALID; ++b)
+        if(plan.contains(b)) return false;
+    return true;
+}
+
+/**
+ * Contracts specified restorable uv arc preserving graph ids, the other
+ * out-arcs of u being removed. If the contraction would need an option
+ * conjunction, u is kept with uv as only out-arc.
+ *
+ * @time \f$O(deg(u) * \#options(u))\f$
+ * @space \f$O(1)\f$
  */
 void ContractionPrecomputation::contract_restorable_arc(
     MutableLandscape & landscape, RestorationPlan<MutableLandscape> & plan,
@@ -80,38 +97,65 @@ void ContractionPrecomputation::contract_restorable_arc(
     const MutableLandscape::Graph & graph = landscape.getNetwork();
     assert(graph.valid(a));
     assert(plan.contains(a));
-    static_cast<void>(plan);
-    // bool contractable = restorable_arc_is_contractable(landscape, plan, a);
 
     MutableLandscape::Node u = graph.source(a);
-    // if(!contractable) {
     for(MutableLandscape::Graph::OutArcIt b(graph, u), next_b = b;
         b != lemon::INVALID; b = next_b) {
         ++next_b;
         if(a == b) continue;
         landscape.removeArc(b);
     }
-    //     return;
-    // }
+    if(!restorable_arc_is_contractable(landscape, plan, a)) return;
 
-    // MutableLandscape::Node v = graph.target(a);
-    // const double a_probability = landscape.getProbability(a);
-    // RestorationPlan<MutableLandscape>::Option a_option =
-    // plan[a].begin()->option; const double a_restored_prob =
-    // plan[a].begin()->restored_probability;
-    // for(MutableLandscape::Graph::InArcIt b(graph, u), next_b=b;
-    // b!=lemon::INVALID; b=next_b) {
-    //     ++next_b;
-    //     landscape.changeTarget(b, v);
-    //     landscape.getProbabilityRef(b) *= a_probability;
-    //     for(auto & e : plan[b])
-    //         e.restored_probability *= a_restored_prob;
-    // }
+    MutableLandscape::Node v = graph.target(a);
+    const double a_probability = landscape.getProbability(a);
+    const RestorationPlan<MutableLandscape>::ArcRestorationsList a_options =
+        plan[a];
+    // an element restoring below the probability leaves the arc unchanged :
+    // the composition uses max(p, r) on both sides
+    auto restored = [](double probability, double restored_probability) {
+        return std::max(probability, restored_probability);
+    };
+    for(MutableLandscape::Graph::InArcIt b(graph, u), next_b = b;
+        b != lemon::INVALID; b = next_b) {
+        ++next_b;
+        // a path through the cycle v->u->v is never better
+        if(graph.source(b) == v) {
+            plan.removeArc(b);
+            landscape.removeArc(b);
+            continue;
+        }
+        const double b_probability = landscape.getProbability(b);
+        landscape.changeTarget(b, v);
+        landscape.setProbability(b, a_probability * b_probability);
+        // b is restored by the option of a only or not restorable
+        if(plan.contains(b)) {
+            for(auto & e : plan[b])
+                e.restored_probability =
+                    restored(b_probability, e.restored_probability) *
+                    restored(a_probability,
+                             a_options.begin()->restored_probability);
+            continue;
+        }
+        for(const auto & e : a_options)
+            plan.addArc(e.option, b, b_probability * e.restored_probability);
+    }
 
-    // landscape.getQualityRef(v) += a_probability * landscape.getQuality(u);
-    // plan.addNode(a_option, v, (a_restored_prob-a_probability) *
-    // landscape.getQuality(u)); for(auto & e : plan[u])
-    //     plan.addNode(e.option, v, a_restored_prob * e.quality_gain);
-    // landscape.removeNode(u);
-    // landscape.getQualityRef(u) = 0;
-}
\ No newline at end of file
+    const double u_quality = landscape.getQuality(u);
+    landscape.setQuality(v, landscape.getQuality(v) +
+                                a_probability * u_quality);
+    // with several options u has no quality
+    if(a_options.size() == 1) {
+        const auto & a_element = *a_options.begin();
+        const double a_restored_probability =
+            restored(a_probability, a_element.restored_probability);
+        double quality_gain =
+            (a_restored_probability - a_probability) * u_quality;
+        for(const auto & e : plan[u])
+            quality_gain += a_restored_probability * e.quality_gain;
+        if(quality_gain > 0) plan.addNode(a_element.option, v, quality_gain);
+    }
+    plan.removeNode(u);
+    plan.removeArc(a);
+    landscape.removeNode(u);
+}
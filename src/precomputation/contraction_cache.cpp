@@ -0,0 +1,345 @@
+#include "precomputation/contraction_cache.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <type_traits>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <fmt/format.h>
+
+namespace {
+constexpr std::uint32_t CACHE_MAGIC = 0x4c4f4343;  // "LOCC"
+// to bump whenever the contracted instances change for a same input
+// 3 : contract_restorable_arc composes the elements with max(p, r)
+// 4 : the target-centric strategy does not label the ties as strong
+constexpr std::uint32_t CACHE_VERSION = 4;
+
+class Hasher {
+private:
+    std::uint64_t hash = 0xcbf29ce484222325ull;  // FNV-1a offset basis
+
+public:
+    template <typename T>
+    void add(const T & value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for(unsigned char byte : bytes) {
+            hash ^= byte;
+            hash *= 0x100000001b3ull;
+        }
+    }
+    std::uint64_t value() const { return hash; }
+};
+
+// the strategy run by MyContractionAlgorithm::precompute on every arc
+StrongUselessStrategy resolved_strategy(
+    const MutableLandscape & landscape,
+    const std::vector<MutableLandscape::Node> & target_nodes,
+    const StrongUselessStrategy strategy) {
+    return resolve_strategy(strategy, target_nodes.size(),
+                            lemon::countArcs(landscape.getNetwork()));
+}
+
+class Writer {
+private:
+    std::vector<char> buffer;
+
+public:
+    template <typename T>
+    void write(const T & value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const char * bytes = reinterpret_cast<const char *>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+    const std::vector<char> & data() const { return buffer; }
+};
+
+// reads from the mapped file without alignment assumptions
+class Reader {
+private:
+    const char * current;
+    const char * end;
+
+public:
+    Reader(const char * data, std::size_t size)
+        : current(data), end(data + size) {}
+
+    template <typename T>
+    bool read(T & value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if(static_cast<std::size_t>(end - current) < sizeof(T)) return false;
+        std::memcpy(&value, current, sizeof(T));
+        current += sizeof(T);
+        return true;
+    }
+    bool atEnd() const { return current == end; }
+};
+
+void write_result(Writer & writer, int orig_t_id, const ContractionResult & cr) {
+    using Graph = StaticLandscape::Graph;
+    const StaticLandscape & landscape = cr.landscape;
+    const RestorationPlan<StaticLandscape> & plan = cr.plan;
+    const Graph & graph = landscape.getNetwork();
+    const int nb_nodes = lemon::countNodes(graph);
+    const int nb_arcs = lemon::countArcs(graph);
+
+    writer.write<std::int32_t>(orig_t_id);
+    writer.write<std::int32_t>(graph.id(cr.t));
+    writer.write<std::int32_t>(nb_nodes);
+    writer.write<std::int32_t>(nb_arcs);
+    writer.write<std::int32_t>(plan.getNbOptions());
+    writer.write<std::int32_t>(plan.getNbNodeRestorationElements());
+    writer.write<std::int32_t>(plan.getNbArcRestorationElements());
+    // the static graph ids are contiguous and its arcs are sorted by source
+    for(int u_id = 0; u_id < nb_nodes; ++u_id) {
+        const Graph::Node u = graph.nodeFromId(u_id);
+        writer.write<double>(landscape.getQuality(u));
+        writer.write<double>(landscape.getCoords(u).x);
+        writer.write<double>(landscape.getCoords(u).y);
+    }
+    for(int a_id = 0; a_id < nb_arcs; ++a_id) {
+        const Graph::Arc a = graph.arcFromId(a_id);
+        writer.write<std::int32_t>(graph.id(graph.source(a)));
+        writer.write<std::int32_t>(graph.id(graph.target(a)));
+        writer.write<double>(landscape.getProbability(a));
+    }
+    for(const RestorationPlan<StaticLandscape>::Option i : plan.options())
+        writer.write<double>(plan.getCost(i));
+    for(int u_id = 0; u_id < nb_nodes; ++u_id)
+        for(const auto & e : plan[graph.nodeFromId(u_id)]) {
+            writer.write<std::int32_t>(u_id);
+            writer.write<std::int32_t>(e.option);
+            writer.write<double>(e.quality_gain);
+        }
+    for(int a_id = 0; a_id < nb_arcs; ++a_id)
+        for(const auto & e : plan[graph.arcFromId(a_id)]) {
+            writer.write<std::int32_t>(a_id);
+            writer.write<std::int32_t>(e.option);
+            writer.write<double>(e.restored_probability);
+        }
+}
+
+std::shared_ptr<ContractionResult> read_result(Reader & reader,
+                                               std::int32_t & orig_t_id) {
+    using Graph = StaticLandscape::Graph;
+    std::int32_t t_id, nb_nodes, nb_arcs, nb_options, nb_node_elements,
+        nb_arc_elements;
+    if(!reader.read(orig_t_id) || !reader.read(t_id) ||
+       !reader.read(nb_nodes) || !reader.read(nb_arcs) ||
+       !reader.read(nb_options) || !reader.read(nb_node_elements) ||
+       !reader.read(nb_arc_elements))
+        return nullptr;
+    if(nb_nodes <= 0 || nb_arcs < 0 || nb_options < 0 ||
+       nb_node_elements < 0 || nb_arc_elements < 0 || t_id < 0 ||
+       t_id >= nb_nodes)
+        return nullptr;
+
+    std::vector<double> node_values(3 * nb_nodes);
+    for(double & value : node_values)
+        if(!reader.read(value)) return nullptr;
+    std::vector<std::pair<int, int>> arcs(nb_arcs);
+    std::vector<double> probabilities(nb_arcs);
+    for(int a_id = 0; a_id < nb_arcs; ++a_id) {
+        std::int32_t source, target;
+        if(!reader.read(source) || !reader.read(target) ||
+           !reader.read(probabilities[a_id]))
+            return nullptr;
+        if(source < 0 || source >= nb_nodes || target < 0 ||
+           target >= nb_nodes || (a_id > 0 && source < arcs[a_id - 1].first))
+            return nullptr;
+        arcs[a_id] = std::make_pair(source, target);
+    }
+
+    auto cr = std::make_shared<ContractionResult>();
+    StaticLandscape & landscape = cr->landscape;
+    RestorationPlan<StaticLandscape> & plan = cr->plan;
+    landscape.build(nb_nodes, arcs.begin(), arcs.end());
+    const Graph & graph = landscape.getNetwork();
+    for(int u_id = 0; u_id < nb_nodes; ++u_id) {
+        const Graph::Node u = graph.nodeFromId(u_id);
+        landscape.setQuality(u, node_values[3 * u_id]);
+        landscape.setCoords(u, Point(node_values[3 * u_id + 1],
+                                     node_values[3 * u_id + 2]));
+    }
+    for(int a_id = 0; a_id < nb_arcs; ++a_id)
+        landscape.setProbability(graph.arcFromId(a_id), probabilities[a_id]);
+    cr->t = graph.nodeFromId(t_id);
+
+    for(int i = 0; i < nb_options; ++i) {
+        double cost;
+        if(!reader.read(cost)) return nullptr;
+        plan.addOption(cost);
+    }
+    for(int k = 0; k < nb_node_elements; ++k) {
+        std::int32_t u_id, option;
+        double quality_gain;
+        if(!reader.read(u_id) || !reader.read(option) ||
+           !reader.read(quality_gain))
+            return nullptr;
+        if(u_id < 0 || u_id >= nb_nodes || !plan.contains(option))
+            return nullptr;
+        plan.addNode(option, graph.nodeFromId(u_id), quality_gain);
+    }
+    for(int k = 0; k < nb_arc_elements; ++k) {
+        std::int32_t a_id, option;
+        double restored_probability;
+        if(!reader.read(a_id) || !reader.read(option) ||
+           !reader.read(restored_probability))
+            return nullptr;
+        if(a_id < 0 || a_id >= nb_arcs || !plan.contains(option))
+            return nullptr;
+        plan.addArc(option, graph.arcFromId(a_id), restored_probability);
+    }
+    return cr;
+}
+}  // namespace
+
+ContractionCache::ContractionCache() : enabled(true) {
+    const char * env_directory = std::getenv("LANDSCAPE_OPT_CACHE_DIR");
+    if(env_directory != nullptr) {
+        directory = env_directory;
+        enabled = !directory.empty();
+        return;
+    }
+    std::error_code ec;
+    directory = std::filesystem::temp_directory_path(ec);
+    if(ec) {
+        enabled = false;
+        return;
+    }
+    directory /= "landscape_opt_cache";
+}
+
+ContractionCache::ContractionCache(const std::filesystem::path & directory)
+    : directory(directory), enabled(!directory.empty()) {}
+
+std::uint64_t ContractionCache::fingerprint(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const StrongUselessStrategy strategy) {
+    using Graph = MutableLandscape::Graph;
+    const Graph & graph = landscape.getNetwork();
+    Hasher hasher;
+    hasher.add(CACHE_VERSION);
+    hasher.add(strategy);
+    hasher.add(lemon::countNodes(graph));
+    hasher.add(lemon::countArcs(graph));
+    for(Graph::NodeIt u(graph); u != lemon::INVALID; ++u) {
+        hasher.add(graph.id(u));
+        hasher.add(landscape.getQuality(u));
+        hasher.add(landscape.getCoords(u).x);
+        hasher.add(landscape.getCoords(u).y);
+        for(const auto & e : plan[u]) {
+            hasher.add(e.option);
+            hasher.add(e.quality_gain);
+        }
+    }
+    for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a) {
+        hasher.add(graph.id(a));
+        hasher.add(graph.id(graph.source(a)));
+        hasher.add(graph.id(graph.target(a)));
+        hasher.add(landscape.getProbability(a));
+        for(const auto & e : plan[a]) {
+            hasher.add(e.option);
+            hasher.add(e.restored_probability);
+        }
+    }
+    hasher.add(plan.getNbOptions());
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        hasher.add(plan.getCost(i));
+    return hasher.value();
+}
+
+std::filesystem::path ContractionCache::path(std::uint64_t fingerprint) const {
+    return directory / fmt::format("contraction_{:016x}.bin", fingerprint);
+}
+
+std::unique_ptr<ContractionCache::ResultsMap> ContractionCache::load(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const std::vector<MutableLandscape::Node> & target_nodes,
+    const StrongUselessStrategy strategy) const {
+    using Graph = MutableLandscape::Graph;
+    if(!enabled) return nullptr;
+    const std::uint64_t key = fingerprint(
+        landscape, plan, resolved_strategy(landscape, target_nodes, strategy));
+    const std::filesystem::path file = path(key);
+    std::error_code ec;
+    if(!std::filesystem::is_regular_file(file, ec) ||
+       std::filesystem::file_size(file, ec) == 0)
+        return nullptr;
+
+    const Graph & graph = landscape.getNetwork();
+    auto results = std::make_unique<ResultsMap>(graph, nullptr);
+    try {
+        boost::iostreams::mapped_file_source mapped(file.string());
+        Reader reader(mapped.data(), mapped.size());
+        std::uint32_t magic, version;
+        std::uint64_t stored_key, nb_results;
+        if(!reader.read(magic) || !reader.read(version) ||
+           !reader.read(stored_key) || !reader.read(nb_results))
+            return nullptr;
+        if(magic != CACHE_MAGIC || version != CACHE_VERSION ||
+           stored_key != key)
+            return nullptr;
+        for(std::uint64_t k = 0; k < nb_results; ++k) {
+            std::int32_t orig_t_id;
+            std::shared_ptr<ContractionResult> cr =
+                read_result(reader, orig_t_id);
+            if(!cr || orig_t_id < 0 || orig_t_id > graph.maxNodeId())
+                return nullptr;
+            const Graph::Node orig_t = graph.nodeFromId(orig_t_id);
+            if(!graph.valid(orig_t)) return nullptr;
+            (*results)[orig_t] = std::move(cr);
+        }
+        if(!reader.atEnd()) return nullptr;
+    } catch(const std::exception &) {
+        return nullptr;
+    }
+    for(Graph::Node t : target_nodes)
+        if(!(*results)[t]) return nullptr;
+    return results;
+}
+
+void ContractionCache::store(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const std::vector<MutableLandscape::Node> & target_nodes,
+    const StrongUselessStrategy strategy, const ResultsMap & results) const {
+    if(!enabled) return;
+    const MutableLandscape::Graph & graph = landscape.getNetwork();
+    const std::uint64_t key = fingerprint(
+        landscape, plan, resolved_strategy(landscape, target_nodes, strategy));
+    Writer writer;
+    writer.write(CACHE_MAGIC);
+    writer.write(CACHE_VERSION);
+    writer.write(key);
+    writer.write<std::uint64_t>(target_nodes.size());
+    for(MutableLandscape::Node t : target_nodes)
+        write_result(writer, graph.id(t), *results[t]);
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if(ec) return;
+    const std::filesystem::path file = path(key);
+    // unique among the processes writing the same instance
+    const std::filesystem::path tmp_file =
+        directory / fmt::format("{}.tmp.{:08x}", file.filename().string(),
+                                std::random_device()());
+    {
+        std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+        if(!out) return;
+        out.write(writer.data().data(), writer.data().size());
+        if(!out) {
+            out.close();
+            std::filesystem::remove(tmp_file, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp_file, file, ec);
+    if(ec) std::filesystem::remove(tmp_file, ec);
+}
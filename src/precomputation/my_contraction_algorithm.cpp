@@ -1,5 +1,178 @@
 #include "precomputation/my_contraction_algorithm.hpp"
 
+#include <numeric>
+
+ContractionBase::ContractionBase(const MutableLandscape::Graph & graph)
+    : in_offsets(graph.maxNodeId() + 2, 0)
+    , sources(graph.maxArcId() + 1, -1) {
+    using Graph = MutableLandscape::Graph;
+    for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a) {
+        sources[graph.id(a)] = graph.id(graph.source(a));
+        ++in_offsets[graph.id(graph.target(a)) + 1];
+    }
+    std::partial_sum(in_offsets.begin(), in_offsets.end(), in_offsets.begin());
+    in_arcs.resize(in_offsets.back());
+    std::vector<int> next(in_offsets.begin(), in_offsets.end() - 1);
+    for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a)
+        in_arcs[next[graph.id(graph.target(a))]++] = graph.id(a);
+}
+
+ContractionInputs::ContractionInputs(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan)
+    : max_node_id(landscape.getNetwork().maxNodeId())
+    , used_options(plan.getNbOptions(), false) {
+    using Graph = MutableLandscape::Graph;
+    const Graph & graph = landscape.getNetwork();
+    const int nb_arc_ids = graph.maxArcId() + 1;
+    arcs.assign(nb_arc_ids, std::make_pair(-1, -1));
+    p_min.assign(nb_arc_ids, 0.0);
+    arc_elements.resize(nb_arc_ids);
+    node_weights.assign(max_node_id + 1, {0.0, 0.0, 0.0});
+    node_elements.resize(max_node_id + 1);
+    for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a) {
+        const int a_id = graph.id(a);
+        arcs[a_id] = std::make_pair(graph.id(graph.source(a)),
+                                    graph.id(graph.target(a)));
+        p_min[a_id] = landscape.getProbability(a);
+        for(const auto & e : plan[a]) {
+            arc_elements[a_id].emplace_back(e.option, e.restored_probability);
+            used_options[e.option] = true;
+        }
+    }
+    for(Graph::NodeIt u(graph); u != lemon::INVALID; ++u) {
+        const int u_id = graph.id(u);
+        node_weights[u_id] = {landscape.getQuality(u), landscape.getCoords(u).x,
+                              landscape.getCoords(u).y};
+        for(const auto & e : plan[u]) {
+            node_elements[u_id].emplace_back(e.option, e.quality_gain);
+            used_options[e.option] = true;
+        }
+    }
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        costs.push_back(plan.getCost(i));
+}
+
+/**
+ * @return a copy of cr with the options and costs of plan, the elements of
+ * the options i such that removed[i] being dropped
+ */
+static std::shared_ptr<ContractionResult> copy_contraction_result(
+    const ContractionResult & cr,
+    const RestorationPlan<MutableLandscape> & plan,
+    const std::vector<bool> & removed) {
+    using Graph = StaticLandscape::Graph;
+    const Graph & graph = cr.landscape.getNetwork();
+    auto copy = std::make_shared<ContractionResult>();
+    Graph::NodeMap<StaticLandscape::Node> nodesRef(graph);
+    Graph::ArcMap<StaticLandscape::Arc> arcsRef(graph);
+    copy->landscape.build(cr.landscape, nodesRef, arcsRef);
+    copy->t = nodesRef[cr.t];
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        copy->plan.addOption(plan.getCost(i));
+    for(Graph::NodeIt u(graph); u != lemon::INVALID; ++u)
+        for(const auto & e : cr.plan[u])
+            if(!removed[e.option])
+                copy->plan.addNode(e.option, nodesRef[u], e.quality_gain);
+    for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a)
+        for(const auto & e : cr.plan[a])
+            if(!removed[e.option])
+                copy->plan.addArc(e.option, arcsRef[a],
+                                  e.restored_probability);
+    return copy;
+}
+
+MutableLandscape::Node MyContractionAlgorithm::extract_kept_instance(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const ContractionBase & base, MutableLandscape::Node t,
+    const std::vector<int> & deleted_ids, MutableLandscape & kept_landscape,
+    RestorationPlan<MutableLandscape> & kept_plan,
+    std::unordered_map<int, MutableLandscape::Arc> & arcsRef) const {
+    using Graph = MutableLandscape::Graph;
+    const Graph & graph = landscape.getNetwork();
+    std::unordered_map<int, Graph::Node> nodesRef;
+    std::vector<std::pair<int, int>> kept_arcs;  // (arc id, target id)
+
+    auto add_node = [&](int u_id) {
+        const Graph::Node u = graph.nodeFromId(u_id);
+        nodesRef[u_id] = kept_landscape.addNode(landscape.getQuality(u),
+                                                landscape.getCoords(u));
+    };
+    std::vector<int> stack;
+    add_node(graph.id(t));
+    stack.push_back(graph.id(t));
+    while(!stack.empty()) {
+        const int v_id = stack.back();
+        stack.pop_back();
+        for(int k = base.in_offsets[v_id]; k < base.in_offsets[v_id + 1];
+            ++k) {
+            const int a_id = base.in_arcs[k];
+            if(std::binary_search(deleted_ids.begin(), deleted_ids.end(),
+                                  a_id))
+                continue;
+            kept_arcs.emplace_back(a_id, v_id);
+            const int u_id = base.sources[a_id];
+            if(nodesRef.count(u_id) > 0) continue;
+            add_node(u_id);
+            stack.push_back(u_id);
+        }
+    }
+    arcsRef.reserve(kept_arcs.size());
+    for(const auto & [a_id, v_id] : kept_arcs)
+        arcsRef[a_id] = kept_landscape.addArc(
+            nodesRef[base.sources[a_id]], nodesRef[v_id],
+            landscape.getProbability(graph.arcFromId(a_id)));
+
+    assert(kept_plan.getNbOptions() == 0);
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        kept_plan.addOption(plan.getCost(i));
+    for(const auto & [u_id, u] : nodesRef)
+        for(const auto & e : plan[graph.nodeFromId(u_id)])
+            kept_plan.addNode(e.option, u, e.quality_gain);
+    for(const auto & [a_id, a] : arcsRef)
+        for(const auto & e : plan[graph.arcFromId(a_id)])
+            kept_plan.addArc(e.option, a, e.restored_probability);
+
+    return nodesRef[graph.id(t)];
+}
+
+void MyContractionAlgorithm::contract_targets(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const ContractionBase & base,
+    const std::vector<MutableLandscape::Node> & target_nodes,
+    const LabeledArcs & contractables_arcs,
+    const LabeledArcs & deletables_arcs,
+    MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>> &
+        results) const {
+    using Graph = MutableLandscape::Graph;
+    // each worker holds one kept subinstance at a time : the peak memory is
+    // bounded by the number of workers
+    const std::size_t nb_workers = std::min(
+        target_nodes.size(),
+        max_in_flight > 0
+            ? max_in_flight
+            : std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+    std::atomic<std::size_t> cpt_target = 0;
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < nb_workers; ++i) {
+        threads.emplace_back([&](void) {
+            for(std::size_t local_cpt{};
+                (local_cpt = cpt_target.fetch_add(
+                     1, std::memory_order_relaxed)) < target_nodes.size();) {
+                Graph::Node u = target_nodes[local_cpt];
+                const int u_id = landscape.getNetwork().id(u);
+                // distinct targets : the map entries are written once
+                results[u] = contract(landscape, plan, base, u,
+                                      contractables_arcs[u_id],
+                                      deletables_arcs[u_id]);
+            }
+        });
+    }
+    for(auto & thread : threads) thread.join();
+}
+
 std::unique_ptr<
     MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>>>
 MyContractionAlgorithm::precompute(
@@ -24,53 +197,134 @@ MyContractionAlgorithm::precompute(
 
     std::vector<Graph::Arc> arcs;
     for(Graph::ArcIt b(graph); b != lemon::INVALID; ++b) arcs.push_back(b);
-    std::atomic<std::size_t> cpt_arc = 0;
 
-    Graph::NodeMap<bool> node_filter(graph, false);
-    for(Graph::Node u : target_nodes) node_filter[u] = true;
+    const auto [contractables_arcs, deletables_arcs] =
+        compute_strong_and_useless_arcs<
+            Graph, ProbabilityMap,
+            lemon::IdentifyMultiplicativeTraits<Graph, ProbabilityMap>>(
+            graph, p_min, p_max, target_nodes, arcs, strategy);
 
-    Graph::NodeMap<tbb::concurrent_vector<Graph::Arc>> contractables_arcs(
-        graph);
-    Graph::NodeMap<tbb::concurrent_vector<Graph::Arc>> deletables_arcs(graph);
+    const ContractionBase base(graph);
+    contract_targets(landscape, plan, base, target_nodes, contractables_arcs,
+                     deletables_arcs, *results);
+    return results;
+}
 
-    std::vector<std::thread> threads;
-    for(std::size_t i = 0; i < std::thread::hardware_concurrency(); ++i) {
-        threads.emplace_back([&](void) {
-            std::vector<Graph::Node> strong_nodes;
-            std::vector<Graph::Node> useless_nodes;
-            lemon::MultiplicativeIdentifyStrong<Graph, ProbabilityMap>
-                identifyStrong(graph, p_min, p_max);
-            lemon::MultiplicativeIdentifyUseless<Graph, ProbabilityMap>
-                identifyUseless(graph, p_min, p_max);
-            identifyStrong.labeledNodesList(strong_nodes);
-            identifyUseless.labeledNodesList(useless_nodes);
+std::unique_ptr<
+    MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>>>
+MyContractionAlgorithm::precompute(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const std::vector<MutableLandscape::Node> & target_nodes,
+    const ContractionInputs & previous_inputs,
+    const MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>> &
+        previous_results) const {
+    using Graph = MutableLandscape::Graph;
+    using ProbabilityMap = MutableLandscape::ProbabilityMap;
+    using Elements = std::vector<std::pair<int, double>>;
 
-            for(std::size_t local_cpt{};
-                (local_cpt = cpt_arc.fetch_add(1, std::memory_order_relaxed)) <
-                arcs.size();) {
-                    
-                Graph::Arc a = arcs[local_cpt];
-                identifyStrong.run(a);
-                identifyUseless.run(a);
-                for(Graph::Node u : strong_nodes) {
-                    if(!node_filter[u]) continue;
-                    contractables_arcs[u].push_back(a);
-                }
-                for(Graph::Node u : useless_nodes) {
-                    if(!node_filter[u]) continue;
-                    deletables_arcs[u].push_back(a);
-                }
-            }
-        });
+    const Graph & graph = landscape.getNetwork();
+    const ContractionInputs inputs(landscape, plan);
+    // the reused contracted plans are indexed by the previous option ids
+    const std::size_t nb_previous_options = previous_inputs.costs.size();
+    if(inputs.max_node_id != previous_inputs.max_node_id ||
+       inputs.arcs != previous_inputs.arcs ||
+       inputs.costs.size() < nb_previous_options)
+        return precompute(landscape, plan, target_nodes);
+
+    std::vector<bool> removed(nb_previous_options, false);
+    for(std::size_t i = 0; i < nb_previous_options; ++i)
+        removed[i] = previous_inputs.used_options[i] && !inputs.used_options[i];
+    auto same_elements = [&removed](const Elements & previous_elements,
+                                    const Elements & elements) {
+        Elements kept;
+        for(const auto & e : previous_elements)
+            if(!removed[e.first]) kept.push_back(e);
+        return kept == elements;
+    };
+
+    // any other change only matters to the targets reachable from it
+    std::vector<char> affected(inputs.max_node_id + 1, false);
+    std::vector<int> stack;
+    auto mark = [&](int u_id) {
+        if(affected[u_id]) return;
+        affected[u_id] = true;
+        stack.push_back(u_id);
+    };
+    for(std::size_t a_id = 0; a_id < inputs.arcs.size(); ++a_id) {
+        if(inputs.arcs[a_id].first < 0) continue;
+        if(inputs.p_min[a_id] != previous_inputs.p_min[a_id] ||
+           !same_elements(previous_inputs.arc_elements[a_id],
+                          inputs.arc_elements[a_id]))
+            mark(inputs.arcs[a_id].second);
+    }
+    for(Graph::NodeIt u(graph); u != lemon::INVALID; ++u) {
+        const int u_id = graph.id(u);
+        if(inputs.node_weights[u_id] != previous_inputs.node_weights[u_id] ||
+           !same_elements(previous_inputs.node_elements[u_id],
+                          inputs.node_elements[u_id]))
+            mark(u_id);
+    }
+    while(!stack.empty()) {
+        const Graph::Node u = graph.nodeFromId(stack.back());
+        stack.pop_back();
+        for(Graph::OutArcIt a(graph, u); a != lemon::INVALID; ++a)
+            mark(graph.id(graph.target(a)));
+    }
+
+    auto results =
+        std::make_unique<Graph::NodeMap<std::shared_ptr<ContractionResult>>>(
+            graph);
+    std::vector<Graph::Node> dirty_targets;
+    for(Graph::Node t : target_nodes) {
+        if(affected[graph.id(t)] || !previous_results[t]) {
+            dirty_targets.push_back(t);
+            continue;
+        }
+        // the previous results may still be used by the caller
+        (*results)[t] =
+            copy_contraction_result(*previous_results[t], plan, removed);
+    }
+    if(dirty_targets.empty()) return results;
+
+    // only the arcs reaching a dirty target can be strong for it
+    const ContractionBase base(graph);
+    std::vector<char> reaching(inputs.max_node_id + 1, false);
+    std::vector<Graph::Arc> arcs;
+    for(Graph::Node t : dirty_targets) {
+        if(reaching[graph.id(t)]) continue;
+        reaching[graph.id(t)] = true;
+        stack.push_back(graph.id(t));
+    }
+    while(!stack.empty()) {
+        const int v_id = stack.back();
+        stack.pop_back();
+        for(int k = base.in_offsets[v_id]; k < base.in_offsets[v_id + 1];
+            ++k) {
+            const int a_id = base.in_arcs[k];
+            arcs.push_back(graph.arcFromId(a_id));
+            const int u_id = base.sources[a_id];
+            if(reaching[u_id]) continue;
+            reaching[u_id] = true;
+            stack.push_back(u_id);
+        }
+    }
+
+    const ProbabilityMap & p_min = landscape.getProbabilityMap();
+    ProbabilityMap p_max(graph);
+    for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a) {
+        p_max[a] = p_min[a];
+        for(const auto & e : plan[a])
+            p_max[a] = std::max(p_max[a], e.restored_probability);
     }
-    for(auto & thread : threads) thread.join();
 
-    std::for_each(std::execution::unseq,
-                  target_nodes.begin(), target_nodes.end(), [&](Graph::Node u) {
-                      (*results)[u] =
-                          contract(landscape, plan, u, contractables_arcs[u],
-                                   deletables_arcs[u]);
-                  });
+    const auto [contractables_arcs, deletables_arcs] =
+        compute_strong_and_useless_arcs<
+            Graph, ProbabilityMap,
+            lemon::IdentifyMultiplicativeTraits<Graph, ProbabilityMap>>(
+            graph, p_min, p_max, dirty_targets, arcs, strategy);
+    contract_targets(landscape, plan, base, dirty_targets, contractables_arcs,
+                     deletables_arcs, *results);
     return results;
 }
 
@@ -0,0 +1,112 @@
+#include "precomputation/options_presolve.hpp"
+
+#include <algorithm>
+
+void copy_options(const RestorationPlan<MutableLandscape> & plan,
+                  RestorationPlan<MutableLandscape> & copy) {
+    assert(copy.getNbOptions() == 0);
+    const MutableLandscape::Graph & graph = plan.getLandscape().getNetwork();
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        copy.addOption(plan.getCost(i));
+    for(MutableLandscape::NodeIt u(graph); u != lemon::INVALID; ++u)
+        for(const auto & e : plan[u])
+            copy.addNode(e.option, u, e.quality_gain);
+    for(MutableLandscape::ArcIt a(graph); a != lemon::INVALID; ++a)
+        for(const auto & e : plan[a])
+            copy.addArc(e.option, a, e.restored_probability);
+}
+
+void remove_options(RestorationPlan<MutableLandscape> & plan,
+                    const std::vector<bool> & removed) {
+    const MutableLandscape::Graph & graph = plan.getLandscape().getNetwork();
+    auto is_removed = [&removed](const auto & e) { return removed[e.option]; };
+    for(MutableLandscape::NodeIt u(graph); u != lemon::INVALID; ++u) {
+        auto & elements = plan[u];
+        elements.erase(
+            std::remove_if(elements.begin(), elements.end(), is_removed),
+            elements.end());
+    }
+    for(MutableLandscape::ArcIt a(graph); a != lemon::INVALID; ++a) {
+        auto & elements = plan[a];
+        elements.erase(
+            std::remove_if(elements.begin(), elements.end(), is_removed),
+            elements.end());
+    }
+}
+
+int remove_over_budget_options(RestorationPlan<MutableLandscape> & plan,
+                               const double B) {
+    std::vector<bool> removed(plan.getNbOptions(), false);
+    int nb_removed = 0;
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
+        if(plan.getCost(i) <= B) continue;
+        removed[i] = true;
+        ++nb_removed;
+    }
+    if(nb_removed > 0) remove_options(plan, removed);
+    return nb_removed;
+}
+
+int remove_dominated_options(RestorationPlan<MutableLandscape> & plan) {
+    using Option = RestorationPlan<MutableLandscape>::Option;
+    const auto nodeOptions = plan.computeNodeOptionsMap();
+    const auto arcOptions = plan.computeArcOptionsMap();
+
+    auto dominates = [&](Option j, Option i) {
+        if(plan.getCost(j) > plan.getCost(i)) return false;
+        for(const auto & [a, restored_probability] : arcOptions[i]) {
+            const auto & elements = plan[a];
+            auto it = std::find_if(elements.begin(), elements.end(),
+                                   [j](const auto & e) { return e.option == j; });
+            if(it == elements.end() ||
+               it->restored_probability < restored_probability)
+                return false;
+        }
+        return true;
+    };
+
+    std::vector<bool> removed(plan.getNbOptions(), false);
+    int nb_removed = 0;
+    for(const Option i : plan.options()) {
+        if(!nodeOptions[i].empty() || arcOptions[i].empty()) continue;
+        // the dominating options restore the first arc of i
+        for(const auto & e : plan[arcOptions[i].front().first]) {
+            const Option j = e.option;
+            if(j == i || !dominates(j, i)) continue;
+            // identical options : keep the smallest ID
+            if(j > i && nodeOptions[j].empty() && dominates(i, j)) continue;
+            removed[i] = true;
+            ++nb_removed;
+            break;
+        }
+    }
+    if(nb_removed > 0) remove_options(plan, removed);
+    return nb_removed;
+}
+
+int reduced_cost_fixing(const std::vector<double> & y_values,
+                        const std::vector<double> & reduced_costs,
+                        const double lp_bound, const double incumbent_value,
+                        std::vector<int> & fixed, const double epsilon) {
+    assert(y_values.size() == reduced_costs.size());
+    assert(y_values.size() == fixed.size());
+    const double threshold =
+        incumbent_value - epsilon * std::max(1.0, std::abs(incumbent_value));
+    int nb_fixed = 0;
+    for(std::size_t i = 0; i < y_values.size(); ++i) {
+        if(fixed[i] >= 0) continue;
+        // y_i = 1 costs at least -reduced_cost
+        if(y_values[i] <= epsilon && lp_bound + reduced_costs[i] < threshold) {
+            fixed[i] = 0;
+            ++nb_fixed;
+            continue;
+        }
+        // y_i = 0 costs at least reduced_cost
+        if(y_values[i] >= 1 - epsilon &&
+           lp_bound - reduced_costs[i] < threshold) {
+            fixed[i] = 1;
+            ++nb_fixed;
+        }
+    }
+    return nb_fixed;
+}
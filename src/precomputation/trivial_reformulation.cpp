@@ -115,6 +115,207 @@ void aggregate_parallel_arcs(MutableLandscape & landscape,
     }
 }
 
+// the probability of the best path from u to v avoiding the arc a in the
+// worst scenario, among the paths of at most max_hops arcs, or 0 if it is
+// lower than threshold. A path of more arcs may be missed, since the nodes are
+// only settled once.
+static double best_other_path(
+    const MutableLandscape & landscape, MutableLandscape::Arc a,
+    double threshold, int max_hops, std::vector<double> & dist,
+    std::vector<MutableLandscape::Graph::Node> & reached) {
+    using Graph = MutableLandscape::Graph;
+    using Entry = std::tuple<double, int, Graph::Node>;
+    const Graph & graph = landscape.getNetwork();
+    const Graph::Node v = graph.target(a);
+    std::priority_queue<Entry> heap;
+    double result = 0;
+
+    dist[graph.id(graph.source(a))] = 1;
+    reached.push_back(graph.source(a));
+    heap.emplace(1, 0, graph.source(a));
+    while(!heap.empty()) {
+        const auto [d, hops, w] = heap.top();
+        heap.pop();
+        if(d < threshold) break;
+        if(d < dist[graph.id(w)]) continue;
+        if(w == v) {
+            result = d;
+            break;
+        }
+        if(hops == max_hops) continue;
+        for(Graph::OutArcIt b(graph, w); b != lemon::INVALID; ++b) {
+            if(b == a) continue;
+            const Graph::Node x = graph.target(b);
+            const double new_d = d * landscape.getProbability(b);
+            if(new_d <= dist[graph.id(x)]) continue;
+            if(dist[graph.id(x)] == 0) reached.push_back(x);
+            dist[graph.id(x)] = new_d;
+            heap.emplace(new_d, hops + 1, x);
+        }
+    }
+    for(const Graph::Node w : reached) dist[graph.id(w)] = 0;
+    reached.clear();
+    return result;
+}
+
+void remove_dominated_arcs(MutableLandscape & landscape,
+                           RestorationPlan<MutableLandscape> & plan,
+                           const int max_hops) {
+    using Graph = MutableLandscape::Graph;
+    using Option = RestorationPlan<MutableLandscape>::Option;
+    const Graph & graph = landscape.getNetwork();
+
+    std::vector<double> dist(graph.maxNodeId() + 1, 0);
+    std::vector<Graph::Node> reached;
+    std::vector<Option> dominated_options;
+    for(Graph::ArcIt a(graph), next_a = a; a != lemon::INVALID; a = next_a) {
+        ++next_a;
+        const double probability = landscape.getProbability(a);
+        // the elements that do not improve the arc are useless anyway
+        dominated_options.clear();
+        for(const auto & e : plan[a])
+            if(e.restored_probability <= probability)
+                dominated_options.push_back(e.option);
+        for(const Option i : dominated_options) plan.removeArc(i, a);
+
+        // the remaining elements improve the arc, so only them can be
+        // dominated if any
+        double threshold = plan.contains(a) ? 1 : probability;
+        for(const auto & e : plan[a])
+            threshold = std::min(threshold, e.restored_probability);
+        const double other =
+            best_other_path(landscape, a, threshold, max_hops, dist, reached);
+        if(other == 0) continue;
+
+        dominated_options.clear();
+        for(const auto & e : plan[a])
+            if(e.restored_probability <= other)
+                dominated_options.push_back(e.option);
+        for(const Option i : dominated_options) plan.removeArc(i, a);
+        if(probability > other || plan.contains(a)) continue;
+        landscape.removeArc(a);
+    }
+}
+
+void remove_dead_end_nodes(MutableLandscape & landscape,
+                           RestorationPlan<MutableLandscape> & plan) {
+    using Graph = MutableLandscape::Graph;
+    const Graph & graph = landscape.getNetwork();
+    for(Graph::NodeIt u(graph), next_u = u; u != lemon::INVALID; u = next_u) {
+        ++next_u;
+        if(landscape.getQuality(u) != 0 || plan.contains(u)) continue;
+        if(Graph::InArcIt(graph, u) != lemon::INVALID &&
+           Graph::OutArcIt(graph, u) != lemon::INVALID)
+            continue;
+        for(Graph::InArcIt a(graph, u); a != lemon::INVALID; ++a)
+            plan.removeArc(a);
+        for(Graph::OutArcIt a(graph, u); a != lemon::INVALID; ++a)
+            plan.removeArc(a);
+        landscape.removeNode(u);
+    }
+}
+
+// the restoration elements of the series composition of arcs restored by
+// elements_1 and elements_2, false if it needs an options conjunction. A
+// restored arc has probability max(p, r) : the composition multiplies these
+// on both sides.
+template <typename Elements>
+static bool series_elements(
+    const Elements & elements_1, double probability_1,
+    const Elements & elements_2, double probability_2,
+    std::vector<std::pair<RestorationPlan<MutableLandscape>::Option, double>> &
+        elements) {
+    elements.clear();
+    if(elements_1.empty() || elements_2.empty()) {
+        for(const auto & e : elements_1)
+            elements.emplace_back(
+                e.option,
+                std::max(probability_1, e.restored_probability) *
+                    probability_2);
+        for(const auto & e : elements_2)
+            elements.emplace_back(
+                e.option,
+                probability_1 *
+                    std::max(probability_2, e.restored_probability));
+        return true;
+    }
+    if(elements_1.size() > 1 || elements_2.size() > 1) return false;
+    const auto & e_1 = *elements_1.begin();
+    const auto & e_2 = *elements_2.begin();
+    if(e_1.option != e_2.option) return false;
+    elements.emplace_back(
+        e_1.option, std::max(probability_1, e_1.restored_probability) *
+                        std::max(probability_2, e_2.restored_probability));
+    return true;
+}
+
+void contract_series_nodes(MutableLandscape & landscape,
+                           RestorationPlan<MutableLandscape> & plan) {
+    using Graph = MutableLandscape::Graph;
+    using Option = RestorationPlan<MutableLandscape>::Option;
+    const Graph & graph = landscape.getNetwork();
+
+    std::vector<Graph::Arc> in_arcs, out_arcs;
+    std::vector<Graph::Node> neighbors;
+    std::vector<std::pair<Option, double>> elements;
+    auto add_neighbor = [&](Graph::Node w) {
+        if(std::find(neighbors.begin(), neighbors.end(), w) == neighbors.end())
+            neighbors.push_back(w);
+    };
+    for(Graph::NodeIt u(graph), next_u = u; u != lemon::INVALID; u = next_u) {
+        ++next_u;
+        if(landscape.getQuality(u) != 0 || plan.contains(u)) continue;
+        in_arcs.clear();
+        out_arcs.clear();
+        neighbors.clear();
+        for(Graph::InArcIt a(graph, u); a != lemon::INVALID; ++a) {
+            in_arcs.push_back(a);
+            add_neighbor(graph.source(a));
+        }
+        const std::size_t nb_sources = neighbors.size();
+        for(Graph::OutArcIt a(graph, u); a != lemon::INVALID; ++a) {
+            out_arcs.push_back(a);
+            add_neighbor(graph.target(a));
+        }
+        // no self loop, no parallel arcs and at most two neighbors
+        if(in_arcs.empty() || out_arcs.empty() || neighbors.size() > 2 ||
+           in_arcs.size() != nb_sources ||
+           std::find(neighbors.begin(), neighbors.end(), u) !=
+               neighbors.end())
+            continue;
+        if(out_arcs.size() == 2 &&
+           graph.target(out_arcs[0]) == graph.target(out_arcs[1]))
+            continue;
+
+        bool reducible = true;
+        for(Graph::Arc b : in_arcs)
+            for(Graph::Arc c : out_arcs) {
+                if(graph.source(b) == graph.target(c)) continue;
+                reducible = reducible &&
+                            series_elements(plan[b], landscape.getProbability(b),
+                                            plan[c], landscape.getProbability(c),
+                                            elements);
+            }
+        if(!reducible) continue;
+
+        for(Graph::Arc b : in_arcs)
+            for(Graph::Arc c : out_arcs) {
+                if(graph.source(b) == graph.target(c)) continue;
+                series_elements(plan[b], landscape.getProbability(b), plan[c],
+                                landscape.getProbability(c), elements);
+                const Graph::Arc bc = landscape.addArc(
+                    graph.source(b), graph.target(c),
+                    landscape.getProbability(b) * landscape.getProbability(c));
+                plan.removeArc(bc);
+                for(const auto & [option, restored_probability] : elements)
+                    plan.addArc(option, bc, restored_probability);
+            }
+        for(Graph::Arc b : in_arcs) plan.removeArc(b);
+        for(Graph::Arc c : out_arcs) plan.removeArc(c);
+        landscape.removeNode(u);
+    }
+}
+
 Instance copy_and_compact_instance(
     const MutableLandscape & landscape,
     const RestorationPlan<MutableLandscape> & plan) {
@@ -146,10 +347,19 @@ Instance copy_and_compact_instance(const Instance & instance) {
 
 Instance trivial_reformulate(MutableLandscape && landscape,
                              RestorationPlan<MutableLandscape> && plan) {
-    remove_zero_probability_arcs(landscape, plan);
-    remove_no_flow_nodes(landscape, plan);
-    contract_patches_components(landscape, plan);
-    aggregate_parallel_arcs(landscape, plan);
+    const MutableLandscape::Graph & graph = landscape.getNetwork();
+    // every reduction that applies removes a node or an arc
+    int size;
+    do {
+        size = lemon::countNodes(graph) + lemon::countArcs(graph);
+        remove_zero_probability_arcs(landscape, plan);
+        remove_no_flow_nodes(landscape, plan);
+        contract_patches_components(landscape, plan);
+        aggregate_parallel_arcs(landscape, plan);
+        remove_dominated_arcs(landscape, plan);
+        remove_dead_end_nodes(landscape, plan);
+        contract_series_nodes(landscape, plan);
+    } while(lemon::countNodes(graph) + lemon::countArcs(graph) < size);
     return copy_and_compact_instance(landscape, plan);
 }
 Instance trivial_reformulate(Instance && instance) {
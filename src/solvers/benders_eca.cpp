@@ -0,0 +1,217 @@
+#include "solvers/benders_eca.hpp"
+
+#include "CoinPackedVector.hpp"
+
+#include "solvers/pl_eca_3_vars.hpp"
+
+namespace Solvers::Benders_ECA_Vars {
+class ThetaVar : public OSI_Builder::VarType {
+public:
+    ThetaVar(int nb_targets) : VarType(nb_targets) {}
+    int id(int target_index) const {
+        assert(target_index >= 0 && target_index < _number);
+        return _offset + target_index;
+    }
+};
+}  // namespace Solvers::Benders_ECA_Vars
+
+using namespace Solvers::PL_ECA_3_Vars;
+using namespace Solvers::Benders_ECA_Vars;
+
+/**
+ * @brief Solves the flow LP of target t for the options values y_values.
+ *
+ * The LP is built on the fly and minimizes the opposite of the target value
+ * for the reduced costs of the fixed y columns to be the usual derivatives.
+ *
+ * @return the value of target t, and its supergradient with respect to y in
+ * supergradient
+ */
+double solve_target_subproblem(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, MutableLandscape::Node t,
+    const PreprocessedDatas & pdatas, const std::vector<double> & y_values,
+    std::vector<std::pair<RestorationPlan<MutableLandscape>::Option, double>> &
+        supergradient) {
+    const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+    OSI_Builder solver_builder;
+    ContractedVars cvars(cr);
+    YVar y(plan);
+    solver_builder.addVarType(&cvars.x)
+        .addVarType(&cvars.restored_x)
+        .addVarType(&cvars.f)
+        .addVarType(&cvars.restored_f)
+        .addVarType(&y);
+    solver_builder.init();
+    fill_target(solver_builder, landscape, plan, t, cvars, y, pdatas);
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        solver_builder.setBounds(y.id(i), y_values[i], y_values[i]);
+    double * objective = solver_builder.getObjective();
+    std::transform(objective, objective + solver_builder.getNbVars(),
+                   objective, std::negate<double>());
+
+    OsiSolverInterface * solver =
+        solver_builder.buildSolver<OsiClpSolverInterface>(OSI_Builder::MIN,
+                                                           true);
+    solver->setHintParam(OsiDoReducePrint);
+    solver->messageHandler()->setLogLevel(0);
+    solver->initialSolve();
+    const double value = -solver->getObjValue();
+    const double * reduced_costs = solver->getReducedCost();
+    supergradient.clear();
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
+        const double derivative = -reduced_costs[y.id(i)];
+        if(std::abs(derivative) <= std::numeric_limits<double>::epsilon())
+            continue;
+        supergradient.emplace_back(i, derivative);
+    }
+    delete solver;
+    return value;
+}
+
+Solution Solvers::Benders_ECA::solve(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B) const {
+    Solution solution(landscape, plan);
+    const int log_level = params.at("log")->getInt();
+    const double gap = params.at("gap")->getDouble();
+    const Deadline deadline = makeDeadline();
+    Chrono chrono;
+    if(log_level > 0)
+        std::cout << name() << ": Start preprocessing" << std::endl;
+    PreprocessedDatas pdatas(landscape, plan, B);
+    solution.preprocessing_time = chrono.lapTimeMs();
+    const std::vector<MutableLandscape::Node> & targets = pdatas.target_nodes;
+    const int nb_targets = targets.size();
+    ////////////////////////////////////////////////////////////////////////
+    // Master : max sum theta_t s.t. sum c_i * y_i <= B and optimality cuts
+    ////////////////////
+    OSI_Builder master_builder;
+    YVar y(plan);
+    ThetaVar theta(nb_targets);
+    master_builder.addVarType(&y).addVarType(&theta);
+    master_builder.init();
+    for(int k = 0; k < nb_targets; ++k) {
+        const MutableLandscape::Node t = targets[k];
+        const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+        double max_quality = landscape.getQuality(t);
+        for(const auto & e : plan[t]) max_quality += e.quality_gain;
+        master_builder.setObjective(theta.id(k), 1);
+        master_builder.setBounds(theta.id(k), 0,
+                                 max_quality * (*pdatas.M_Maps_Map[t])[cr.t]);
+    }
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
+        master_builder.buffEntry(y.id(i), plan.getCost(i));
+        master_builder.setInteger(y.id(i));
+    }
+    master_builder.pushRow(-OSI_Builder::INFTY, B);
+    OsiSolverInterface * master =
+        master_builder.buildSolver<OsiClpSolverInterface>(OSI_Builder::MAX);
+    master->setHintParam(OsiDoReducePrint);
+    const int nb_master_vars = master_builder.getNbVars();
+    if(log_level > 0)
+        std::cout << name()
+                  << ": Complete preprocessing : " << solution.preprocessing_time
+                  << " ms" << std::endl;
+    ////////////////////////////////////////////////////////////////////////
+    // Cutting loop
+    ////////////////////
+    std::vector<double> y_values(plan.getNbOptions(), 0.0);
+    std::vector<double> best_master_values;
+    double lower_bound = 0.0;
+    double upper_bound = OSI_Builder::INFTY;
+    std::vector<double> values(nb_targets);
+    std::vector<
+        std::vector<std::pair<RestorationPlan<MutableLandscape>::Option, double>>>
+        supergradients(nb_targets);
+    std::vector<int> target_indices(nb_targets);
+    std::iota(target_indices.begin(), target_indices.end(), 0);
+    int nb_cuts = 0;
+    for(int iteration = 0;; ++iteration) {
+        CbcModel model(*master);
+        model.setLogLevel(log_level >= 3 ? 1 : 0);
+        model.setAllowableGap(1e-10);
+        if(!deadline.isUnlimited())
+            model.setMaximumSeconds(std::max(1.0, deadline.remainingS()));
+        // (best y, theta = target values) satisfies all the cuts
+        if(!best_master_values.empty())
+            model.setBestSolution(best_master_values.data(), nb_master_vars,
+                                  COIN_DBL_MAX, true);
+        CbcMain0(model);
+        model.branchAndBound(1);
+        const double * master_solution = model.bestSolution();
+        if(master_solution == nullptr) {
+            std::cerr << name() << ": Fail" << std::endl;
+            delete master;
+            throw "caca";
+        }
+        upper_bound = std::min(upper_bound, model.getBestPossibleObjValue());
+        for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+            y_values[i] = std::round(master_solution[y.id(i)]);
+
+        std::for_each(std::execution::par, target_indices.begin(),
+                      target_indices.end(), [&](int k) {
+                          values[k] = solve_target_subproblem(
+                              landscape, plan, targets[k], pdatas, y_values,
+                              supergradients[k]);
+                      });
+        const double value = std::accumulate(values.begin(), values.end(), 0.0);
+        if(best_master_values.empty() || value > lower_bound) {
+            lower_bound = value;
+            best_master_values.assign(nb_master_vars, 0.0);
+            for(const RestorationPlan<MutableLandscape>::Option i :
+                plan.options())
+                best_master_values[y.id(i)] = y_values[i];
+            for(int k = 0; k < nb_targets; ++k)
+                best_master_values[theta.id(k)] = values[k];
+        }
+        // theta_t <= v_t(y^) + sum_i d_i * (y_i - y^_i)
+        int nb_new_cuts = 0;
+        for(int k = 0; k < nb_targets; ++k) {
+            if(master_solution[theta.id(k)] <=
+               values[k] + gap * std::max(1.0, values[k]))
+                continue;
+            CoinPackedVector cut;
+            cut.insert(theta.id(k), 1.0);
+            double rhs = values[k];
+            for(const auto & [i, derivative] : supergradients[k]) {
+                cut.insert(y.id(i), -derivative);
+                rhs -= derivative * y_values[i];
+            }
+            master->addRow(cut, -COIN_DBL_MAX, rhs);
+            ++nb_new_cuts;
+        }
+        nb_cuts += nb_new_cuts;
+        if(log_level >= 1)
+            std::cout << name() << ": iteration " << iteration
+                      << " : bounds [" << lower_bound << ", " << upper_bound
+                      << "], " << nb_new_cuts << " new cuts, "
+                      << chrono.lapTimeMs() << " ms" << std::endl;
+        if(nb_new_cuts == 0) break;
+        if(upper_bound - lower_bound <= gap * std::max(1.0, upper_bound))
+            break;
+        if(deadline.expired()) break;
+    }
+    ////////////////////
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        solution.set(i, best_master_values[y.id(i)]);
+    solution.setComputeTimeMs(chrono.timeMs());
+    solution.obj = lower_bound;
+    solution.bound = upper_bound;
+    if(upper_bound - lower_bound <= gap * std::max(1.0, upper_bound))
+        solution.status = Solution::OPTIMAL;
+    else if(deadline.expired())
+        solution.status = Solution::TIMEOUT;
+    solution.nb_vars = nb_master_vars;
+    solution.nb_constraints = master->getNumRows();
+    solution.nb_elems = master->getNumElements();
+    if(log_level >= 1) {
+        std::cout << name()
+                  << ": Complete solving : " << solution.getComputeTimeMs()
+                  << " ms, " << nb_cuts << " cuts" << std::endl;
+        std::cout << name() << ": ECA from obj : " << std::sqrt(solution.obj)
+                  << std::endl;
+    }
+    delete master;
+    return solution;
+}
@@ -7,11 +7,13 @@ Solution Solvers::Glutton_ECA_Dec::solve(
     Solution solution(landscape, plan);
     const int log_level = params.at("log")->getInt();
     const bool parallel = params.at("parallel")->getBool();
+    const Deadline deadline = makeDeadline();
     Chrono chrono;
 
     const MutableLandscape::Graph & graph = landscape.getNetwork();
-    const auto nodeOptions = plan.computeNodeOptionsMap();
-    const auto arcOptions = plan.computeArcOptionsMap();
+    const auto compiled_plan = plan.compile();
+    const auto & nodeOptions = compiled_plan.getNodeOptionsMap();
+    const auto & arcOptions = compiled_plan.getArcOptionsMap();
 
     std::vector<Option> options;
     std::vector<Option> free_options;
@@ -24,7 +26,8 @@ Solution Solvers::Glutton_ECA_Dec::solve(
     }
 
     double prec_eca =
-        ECA().eval(Helper::decore_landscape(landscape, plan, solution));
+        ECA().eval(Helper::decore_landscape(landscape, compiled_plan,
+                                            solution));
     if(log_level > 1) {
         std::cout << "base purchaised: " << purchaised << std::endl;
         std::cout << "base ECA: " << prec_eca << std::endl;
@@ -48,6 +51,18 @@ Solution Solvers::Glutton_ECA_Dec::solve(
         return std::pair<double, Option>(ratio, option);
     };
     while(purchaised > B) {
+        // out of time : removes the most expensive options to be feasible
+        if(deadline.expired()) {
+            solution.status = Solution::TIMEOUT;
+            auto most_expensive = std::max_element(
+                options.begin(), options.end(), [&plan](Option i, Option j) {
+                    return plan.getCost(i) < plan.getCost(j);
+                });
+            purchaised -= plan.getCost(*most_expensive);
+            solution.remove(*most_expensive);
+            options.erase(most_expensive);
+            continue;
+        }
         std::pair<double, Option> worst =
             parallel
                 ? std::transform_reduce(
@@ -112,6 +127,10 @@ Solution Solvers::Glutton_ECA_Dec::solve(
         return std::make_pair(ratio, option);
     };
     for(;;) {
+        if(deadline.expired()) {
+            solution.status = Solution::TIMEOUT;
+            break;
+        }
         // std::cout << "il reste des options: " << free_options.size() << std::endl;
 
         // for(auto option : free_options) {
@@ -174,6 +193,11 @@ Solution Solvers::Glutton_ECA_Dec::solve(
         }
     }
 
+    // the removals without evaluation do not maintain prec_eca
+    if(solution.status == Solution::TIMEOUT)
+        prec_eca =
+            ECA().eval(Helper::decore_landscape(landscape, compiled_plan,
+                                                solution));
     solution.setComputeTimeMs(chrono.timeMs());
     solution.obj = prec_eca;
     if(log_level >= 1) {
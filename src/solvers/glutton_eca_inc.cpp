@@ -6,11 +6,13 @@ Solution Solvers::Glutton_ECA_Inc::solve(
     Solution solution(landscape, plan);
     const int log_level = params.at("log")->getInt();
     const bool parallel = params.at("parallel")->getBool();
+    const Deadline deadline = makeDeadline();
     Chrono chrono;
 
     const MutableLandscape::Graph & graph = landscape.getNetwork();
-    const auto nodeOptions = plan.computeNodeOptionsMap();
-    const auto arcOptions = plan.computeArcOptionsMap();
+    const auto compiled_plan = plan.compile();
+    const auto & nodeOptions = compiled_plan.getNodeOptionsMap();
+    const auto & arcOptions = compiled_plan.getArcOptionsMap();
 
     std::vector<RestorationPlan<MutableLandscape>::Option> options;
     double purchaised = 0.0;
@@ -29,8 +31,13 @@ Solution Solvers::Glutton_ECA_Inc::solve(
             return (p1.first > p2.first) ? p1 : p2;
         };
     auto compute_option =
-        [&landscape, &plan, &nodeOptions, &arcOptions, &prec_eca,
-         &solution](RestorationPlan<MutableLandscape>::Option option) {
+        [&landscape, &plan, &nodeOptions, &arcOptions, &prec_eca, &solution,
+         &deadline](RestorationPlan<MutableLandscape>::Option option) {
+            // the options not evaluated before the deadline are not chosen
+            if(deadline.expired())
+                return std::pair<double,
+                                 RestorationPlan<MutableLandscape>::Option>(
+                    0.0, -1);
             DecoredLandscape<MutableLandscape> decored_landscape(landscape);
             for(RestorationPlan<MutableLandscape>::Option i : plan.options()) {
                 decored_landscape.apply(nodeOptions[i], arcOptions[i],
@@ -44,6 +51,10 @@ Solution Solvers::Glutton_ECA_Inc::solve(
                 ratio, option);
         };
     for(;;) {
+        if(deadline.expired()) {
+            solution.status = Solution::TIMEOUT;
+            break;
+        }
         auto new_end_it =
             std::remove_if(options.begin(), options.end(),
                            [&](RestorationPlan<MutableLandscape>::Option i) {
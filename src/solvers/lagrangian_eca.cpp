@@ -0,0 +1,248 @@
+#include "solvers/lagrangian_eca.hpp"
+
+#include "solvers/pl_eca_3_vars.hpp"
+
+using namespace Solvers::PL_ECA_3_Vars;
+
+/**
+ * @brief Solves the Lagrangian subproblem of target t : the MIP maximizing the
+ * value of t minus sum_i multipliers_i * y_i over its own copy of the relevant
+ * options, that also respects the budget.
+ *
+ * @return the subproblem value, and the choice of the copy in choice, proven
+ * being false if the deadline stopped the MIP before optimality
+ */
+double solve_target_lagrangian_subproblem(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, MutableLandscape::Node t,
+    const PreprocessedDatas & pdatas, const double B,
+    const std::vector<RestorationPlan<MutableLandscape>::Option> & options,
+    const std::vector<double> & multipliers, const Deadline & deadline,
+    std::vector<double> & choice, bool & proven) {
+    const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+    OSI_Builder solver_builder;
+    ContractedVars cvars(cr);
+    YVar y(plan);
+    solver_builder.addVarType(&cvars.x)
+        .addVarType(&cvars.restored_x)
+        .addVarType(&cvars.f)
+        .addVarType(&cvars.restored_f)
+        .addVarType(&y);
+    solver_builder.init();
+    fill_target(solver_builder, landscape, plan, t, cvars, y, pdatas);
+    // the other options do not appear in the rows of t
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        solver_builder.setBounds(y.id(i), 0, 0);
+    for(std::size_t k = 0; k < options.size(); ++k) {
+        const int y_i = y.id(options[k]);
+        solver_builder.setBounds(y_i, 0, 1);
+        solver_builder.setObjective(y_i, -multipliers[k]);
+        solver_builder.setInteger(y_i);
+        solver_builder.buffEntry(y_i, plan.getCost(options[k]));
+    }
+    solver_builder.pushRow(-OSI_Builder::INFTY, B);
+
+    OsiSolverInterface * solver =
+        solver_builder.buildSolver<OsiClpSolverInterface>(OSI_Builder::MAX);
+    solver->setHintParam(OsiDoReducePrint);
+    solver->messageHandler()->setLogLevel(0);
+    solver->initialSolve();
+    CbcModel model(*solver);
+    model.setLogLevel(0);
+    model.setAllowableGap(1e-10);
+    if(!deadline.isUnlimited())
+        model.setMaximumSeconds(deadline.remainingS());
+    model.branchAndBound();
+    proven = model.isProvenOptimal();
+    const double * var_solution = model.bestSolution();
+    choice.assign(options.size(), 0.0);
+    if(var_solution == nullptr) {
+        delete solver;
+        if(proven) throw "caca";
+        return 0.0;
+    }
+    for(std::size_t k = 0; k < options.size(); ++k)
+        choice[k] = std::round(var_solution[y.id(options[k])]);
+    const double value = model.getObjValue();
+    delete solver;
+    return value;
+}
+
+/**
+ * @brief Fractional knapsack : maximizes sum_i profits_i * y_i for
+ * sum_i c_i * y_i <= B and 0 <= y_i <= 1.
+ *
+ * @return the optimal value, the optimal y in y_values
+ */
+double fractional_knapsack(const RestorationPlan<MutableLandscape> & plan,
+                           const double B, const std::vector<double> & profits,
+                           std::vector<double> & y_values) {
+    std::vector<RestorationPlan<MutableLandscape>::Option> options;
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        if(profits[i] > 0) options.push_back(i);
+    std::sort(options.begin(), options.end(), [&](auto i, auto j) {
+        return profits[i] * plan.getCost(j) > profits[j] * plan.getCost(i);
+    });
+    std::fill(y_values.begin(), y_values.end(), 0.0);
+    double value = 0.0;
+    double remaining = B;
+    for(const RestorationPlan<MutableLandscape>::Option i : options) {
+        const double cost = plan.getCost(i);
+        y_values[i] = (cost <= remaining) ? 1.0 : remaining / cost;
+        value += y_values[i] * profits[i];
+        remaining -= y_values[i] * cost;
+        if(remaining <= 0) break;
+    }
+    return value;
+}
+
+Solution Solvers::Lagrangian_ECA::solve(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B) const {
+    Solution solution(landscape, plan);
+    const int log_level = params.at("log")->getInt();
+    const int nb_iterations = params.at("iterations")->getInt();
+    const double gap = params.at("gap")->getDouble();
+    const Deadline deadline = makeDeadline();
+    Chrono chrono;
+    if(log_level > 0)
+        std::cout << name() << ": Start preprocessing" << std::endl;
+    PreprocessedDatas pdatas(landscape, plan, B);
+    solution.preprocessing_time = chrono.lapTimeMs();
+    const std::vector<MutableLandscape::Node> & targets = pdatas.target_nodes;
+    const int nb_targets = targets.size();
+
+    std::vector<std::vector<RestorationPlan<MutableLandscape>::Option>>
+        target_options(nb_targets);
+    std::vector<std::vector<double>> multipliers(nb_targets);
+    std::vector<std::vector<double>> choices(nb_targets);
+    std::vector<double> values(nb_targets);
+    std::vector<char> proven(nb_targets, true);
+    std::vector<int> target_indices(nb_targets);
+    std::iota(target_indices.begin(), target_indices.end(), 0);
+    std::for_each(std::execution::par, target_indices.begin(),
+                  target_indices.end(), [&](int k) {
+                      target_options[k] =
+                          relevant_options(plan, targets[k], pdatas);
+                      multipliers[k].assign(target_options[k].size(), 0.0);
+                  });
+    if(log_level > 0)
+        std::cout << name()
+                  << ": Complete preprocessing : " << solution.preprocessing_time
+                  << " ms" << std::endl;
+
+    const auto compiled_plan = plan.compile();
+    DecoredLandscape<MutableLandscape> decored_landscape(landscape);
+    auto eval = [&](const std::vector<bool> & chosen) {
+        Helper::decore_landscape(decored_landscape, compiled_plan, chosen);
+        const double eca = ECA().eval(decored_landscape);
+        Helper::undecore_landscape(decored_landscape, compiled_plan, chosen);
+        return std::pow(eca, 2);
+    };
+
+    std::vector<double> profits(plan.getNbOptions());
+    std::vector<double> y_values(plan.getNbOptions());
+    std::vector<double> votes(plan.getNbOptions());
+    std::vector<bool> best_chosen(plan.getNbOptions(), false);
+    double lower_bound = eval(best_chosen);
+    double upper_bound = OSI_Builder::INFTY;
+    double step_coef = 2.0;
+    int nb_stalled_iterations = 0;
+    for(int iteration = 0; iteration < nb_iterations; ++iteration) {
+        // subproblems
+        std::for_each(std::execution::par, target_indices.begin(),
+                      target_indices.end(), [&](int k) {
+                          // the value of a target without relevant options
+                          // does not depend on the multipliers
+                          if(iteration > 0 && target_options[k].empty())
+                              return;
+                          bool target_proven;
+                          values[k] = solve_target_lagrangian_subproblem(
+                              landscape, plan, targets[k], pdatas, B,
+                              target_options[k], multipliers[k], deadline,
+                              choices[k], target_proven);
+                          proven[k] = target_proven;
+                      });
+        // y part : max sum_i (sum_t lambda_t_i) * y_i
+        std::fill(profits.begin(), profits.end(), 0.0);
+        for(int k = 0; k < nb_targets; ++k)
+            for(std::size_t l = 0; l < target_options[k].size(); ++l)
+                profits[target_options[k][l]] += multipliers[k][l];
+        const double lagrangian_value =
+            std::accumulate(values.begin(), values.end(), 0.0) +
+            fractional_knapsack(plan, B, profits, y_values);
+        // a subproblem stopped by the deadline does not bound its target
+        const bool bounded =
+            std::all_of(proven.begin(), proven.end(), [](char p) { return p; });
+        if(bounded && lagrangian_value < upper_bound) {
+            upper_bound = lagrangian_value;
+            nb_stalled_iterations = 0;
+        } else if(bounded && ++nb_stalled_iterations >= 5) {
+            step_coef /= 2;
+            nb_stalled_iterations = 0;
+        }
+        // repair : options by decreasing votes per cost, then by profit ratio
+        std::copy(y_values.begin(), y_values.end(), votes.begin());
+        for(int k = 0; k < nb_targets; ++k)
+            for(std::size_t l = 0; l < target_options[k].size(); ++l)
+                votes[target_options[k][l]] += choices[k][l];
+        std::vector<RestorationPlan<MutableLandscape>::Option> options;
+        for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+            if(votes[i] > 0 || profits[i] > 0) options.push_back(i);
+        std::sort(options.begin(), options.end(), [&](auto i, auto j) {
+            if(votes[i] * plan.getCost(j) != votes[j] * plan.getCost(i))
+                return votes[i] * plan.getCost(j) > votes[j] * plan.getCost(i);
+            return profits[i] * plan.getCost(j) > profits[j] * plan.getCost(i);
+        });
+        std::vector<bool> chosen(plan.getNbOptions(), false);
+        double purchaised = 0.0;
+        for(const RestorationPlan<MutableLandscape>::Option i : options) {
+            if(purchaised + plan.getCost(i) > B) continue;
+            chosen[i] = true;
+            purchaised += plan.getCost(i);
+        }
+        const double repaired_value = eval(chosen);
+        if(repaired_value > lower_bound) {
+            lower_bound = repaired_value;
+            best_chosen = chosen;
+        }
+        if(log_level >= 1)
+            std::cout << name() << ": iteration " << iteration << " : bounds ["
+                      << lower_bound << ", " << upper_bound << "], "
+                      << chrono.lapTimeMs() << " ms" << std::endl;
+        if(upper_bound - lower_bound <= gap * std::max(1.0, upper_bound))
+            break;
+        if(deadline.expired() || !bounded) break;
+        // subgradient step : lambda_t_i -= step * (y_i - y_t_i)
+        double norm = 0.0;
+        for(int k = 0; k < nb_targets; ++k)
+            for(std::size_t l = 0; l < target_options[k].size(); ++l)
+                norm += std::pow(y_values[target_options[k][l]] - choices[k][l],
+                                 2);
+        if(norm <= std::numeric_limits<double>::epsilon()) break;
+        const double step =
+            step_coef * (lagrangian_value - lower_bound) / norm;
+        for(int k = 0; k < nb_targets; ++k)
+            for(std::size_t l = 0; l < target_options[k].size(); ++l)
+                multipliers[k][l] -=
+                    step * (y_values[target_options[k][l]] - choices[k][l]);
+    }
+    ////////////////////
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        solution.set(i, best_chosen[i] ? 1.0 : 0.0);
+    solution.setComputeTimeMs(chrono.timeMs());
+    solution.obj = lower_bound;
+    solution.bound = upper_bound;
+    if(upper_bound - lower_bound <= gap * std::max(1.0, upper_bound))
+        solution.status = Solution::OPTIMAL;
+    else if(deadline.expired())
+        solution.status = Solution::TIMEOUT;
+    if(log_level >= 1) {
+        std::cout << name()
+                  << ": Complete solving : " << solution.getComputeTimeMs()
+                  << " ms" << std::endl;
+        std::cout << name() << ": ECA from obj : " << std::sqrt(solution.obj)
+                  << " , bound : " << std::sqrt(solution.bound) << std::endl;
+    }
+    return solution;
+}
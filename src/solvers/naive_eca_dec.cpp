@@ -6,10 +6,12 @@ Solution Solvers::Naive_ECA_Dec::solve(
     Solution solution(landscape, plan);
     const int log_level = params.at("log")->getInt();
     const bool parallel = params.at("parallel")->getBool();
+    const Deadline deadline = makeDeadline();
     Chrono chrono;
 
-    const auto nodeOptions = plan.computeNodeOptionsMap();
-    const auto arcOptions = plan.computeArcOptionsMap();
+    const auto compiled_plan = plan.compile();
+    const auto & nodeOptions = compiled_plan.getNodeOptionsMap();
+    const auto & arcOptions = compiled_plan.getArcOptionsMap();
 
     std::vector<RestorationPlan<MutableLandscape>::Option> free_options;
     std::vector<std::pair<double, RestorationPlan<MutableLandscape>::Option>>
@@ -27,7 +29,8 @@ Solution Solvers::Naive_ECA_Dec::solve(
     }
 
     double prec_eca =
-        ECA().eval(Helper::decore_landscape(landscape, plan, solution));
+        ECA().eval(Helper::decore_landscape(landscape, compiled_plan,
+                                            solution));
     if(log_level > 1) {
         std::cout << "base purchased: " << purchaised << std::endl;
         std::cout << "base ECA: " << prec_eca << std::endl;
@@ -36,8 +39,12 @@ Solution Solvers::Naive_ECA_Dec::solve(
     ratio_options.resize(options.size());
 
     auto compute_dec =
-        [&landscape, &plan, &nodeOptions, &arcOptions, &options,
-         prec_eca](RestorationPlan<MutableLandscape>::Option option) {
+        [&landscape, &plan, &nodeOptions, &arcOptions, &options, prec_eca,
+         &deadline](RestorationPlan<MutableLandscape>::Option option) {
+            // the options not evaluated before the deadline are removed first
+            if(deadline.expired())
+                return std::make_pair(-std::numeric_limits<double>::infinity(),
+                                      option);
             DecoredLandscape<MutableLandscape> decored_landscape(landscape);
             for(RestorationPlan<MutableLandscape>::Option it_option : options) {
                 if(it_option == option) continue;
@@ -74,13 +81,18 @@ Solution Solvers::Naive_ECA_Dec::solve(
                       << "\t purchaised: " << purchaised << std::endl;
     }
 
-    prec_eca = ECA().eval(Helper::decore_landscape(landscape, plan, solution));
+    prec_eca = ECA().eval(
+        Helper::decore_landscape(landscape, compiled_plan, solution));
 
     ratio_free_options.resize(free_options.size());
 
     auto compute_inc = [&landscape, &plan, &nodeOptions, &arcOptions, &solution,
-                        prec_eca](
+                        prec_eca, &deadline](
                            RestorationPlan<MutableLandscape>::Option option) {
+        // the options not evaluated before the deadline come last
+        if(deadline.expired())
+            return std::make_pair(-std::numeric_limits<double>::infinity(),
+                                  option);
         DecoredLandscape<MutableLandscape> decored_landscape(landscape);
         for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
             decored_landscape.apply(nodeOptions[i], arcOptions[i],
@@ -124,6 +136,7 @@ Solution Solvers::Naive_ECA_Dec::solve(
                       << "\t purchaised: " << purchaised << std::endl;
     }
 
+    if(deadline.expired()) solution.status = Solution::TIMEOUT;
     solution.setComputeTimeMs(chrono.timeMs());
 
     return solution;
@@ -6,10 +6,12 @@ Solution Solvers::Naive_ECA_Inc::solve(
     Solution solution(landscape, plan);
     const int log_level = params.at("log")->getInt();
     const bool parallel = params.at("parallel")->getBool();
+    const Deadline deadline = makeDeadline();
     Chrono chrono;
 
-    const auto nodeOptions = plan.computeNodeOptionsMap();
-    const auto arcOptions = plan.computeArcOptionsMap();
+    const auto compiled_plan = plan.compile();
+    const auto & nodeOptions = compiled_plan.getNodeOptionsMap();
+    const auto & arcOptions = compiled_plan.getArcOptionsMap();
 
     double prec_eca = ECA().eval(landscape);
     if(log_level > 1) {
@@ -25,8 +27,13 @@ Solution Solvers::Naive_ECA_Inc::solve(
 
     ratio_options.resize(options.size());
 
-    auto compute = [&landscape, &plan, &nodeOptions, &arcOptions, prec_eca](
+    auto compute = [&landscape, &plan, &nodeOptions, &arcOptions, prec_eca,
+                    &deadline](
                        RestorationPlan<MutableLandscape>::Option option) {
+        // the options not evaluated before the deadline come last
+        if(deadline.expired())
+            return std::make_pair(-std::numeric_limits<double>::infinity(),
+                                  option);
         DecoredLandscape<MutableLandscape> decored_landscape(landscape);
         decored_landscape.apply(nodeOptions[option], arcOptions[option]);
         const double eca = ECA().eval(decored_landscape);
@@ -42,6 +49,8 @@ Solution Solvers::Naive_ECA_Inc::solve(
         std::transform(std::execution::seq, options.begin(), options.end(),
                        ratio_options.begin(), compute);
 
+    if(deadline.expired()) solution.status = Solution::TIMEOUT;
+
     std::sort(
         ratio_options.begin(), ratio_options.end(),
         [](std::pair<double, RestorationPlan<MutableLandscape>::Option> & e1,
@@ -1,18 +1,126 @@
 #include "solvers/pl_eca_2.hpp"
 
-#include "gurobi_c.h"
+#include "solvers/warm_start.hpp"
 
 namespace Solvers::PL_ECA_2_Vars {
+/**
+ * @brief Compact ids of the (target, key) pairs : the keys of each target are
+ * sorted and the id of (t, key) is the offset of t plus the rank of key,
+ * found by binary search.
+ */
+class SparseIds {
+private:
+    std::vector<std::vector<int>> _keys;
+    std::vector<int> _offsets;
+
+public:
+    SparseIds(std::vector<std::vector<int>> && keys)
+        : _keys(std::move(keys)), _offsets(_keys.size() + 1, 0) {
+        for(std::size_t k = 0; k < _keys.size(); ++k) {
+            std::sort(_keys[k].begin(), _keys[k].end());
+            _offsets[k + 1] = _offsets[k] + _keys[k].size();
+        }
+    }
+    int size() const { return _offsets.back(); }
+    const std::vector<int> & keys(int target_id) const {
+        return _keys[target_id];
+    }
+    bool contains(int target_id, int key) const {
+        return std::binary_search(_keys[target_id].begin(),
+                                  _keys[target_id].end(), key);
+    }
+    int id(int target_id, int key) const {
+        const std::vector<int> & keys = _keys[target_id];
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        assert(it != keys.end() && *it == key);
+        return _offsets[target_id] + std::distance(keys.begin(), it);
+    }
+};
+
+/**
+ * @brief Computes, for each target t, the ids of the arcs that can carry flow
+ * to t, i.e. the arcs of positive probability in the best scenario whose
+ * target reaches t through such arcs. Indexed by the ids of the targets, the
+ * nodes that do not appear in the objective have no arcs.
+ */
+std::vector<std::vector<int>> compute_targets_arcs(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan) {
+    const MutableLandscape::Graph & graph = landscape.getNetwork();
+    std::vector<MutableLandscape::Node> targets;
+    for(MutableLandscape::NodeIt t(graph); t != lemon::INVALID; ++t)
+        if(landscape.getQuality(t) > 0 || plan.contains(t))
+            targets.push_back(t);
+    MutableLandscape::Graph::ArcMap<bool> carries_flow(graph);
+    for(MutableLandscape::ArcIt a(graph); a != lemon::INVALID; ++a) {
+        double probability = landscape.getProbability(a);
+        for(auto const & e : plan[a])
+            probability = std::max(probability, e.restored_probability);
+        carries_flow[a] = probability > 0;
+    }
+    std::vector<std::vector<int>> targets_arcs(graph.maxNodeId() + 1);
+    std::for_each(
+        std::execution::par, targets.begin(), targets.end(),
+        [&](MutableLandscape::Node t) {
+            std::vector<int> & arcs = targets_arcs[graph.id(t)];
+            std::vector<bool> reached(graph.maxNodeId() + 1, false);
+            std::vector<MutableLandscape::Node> stack{t};
+            reached[graph.id(t)] = true;
+            while(!stack.empty()) {
+                const MutableLandscape::Node v = stack.back();
+                stack.pop_back();
+                for(MutableLandscape::Graph::InArcIt a(graph, v);
+                    a != lemon::INVALID; ++a) {
+                    if(!carries_flow[a]) continue;
+                    arcs.push_back(graph.id(a));
+                    const MutableLandscape::Node u = graph.source(a);
+                    if(reached[graph.id(u)]) continue;
+                    reached[graph.id(u)] = true;
+                    stack.push_back(u);
+                }
+            }
+        });
+    return targets_arcs;
+}
+
+/**
+ * @brief Computes, for each target t, the ids of the restoration elements of
+ * the arcs of targets_arcs[t].
+ */
+std::vector<std::vector<int>> compute_targets_arc_elements(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const std::vector<std::vector<int>> & targets_arcs) {
+    const MutableLandscape::Graph & graph = landscape.getNetwork();
+    std::vector<std::vector<int>> targets_elements(targets_arcs.size());
+    for(std::size_t k = 0; k < targets_arcs.size(); ++k)
+        for(const int a_id : targets_arcs[k])
+            for(auto const & e : plan[graph.arcFromId(a_id)])
+                targets_elements[k].push_back(e.id);
+    return targets_elements;
+}
+
 class XVar : public OSI_Builder::VarType {
 private:
     const MutableLandscape::Graph & _graph;
-    const int _m;
+    const SparseIds _ids;
 
 public:
-    XVar(const MutableLandscape::Graph & graph, int n, int m)
-        : VarType(n * m, 0, OSI_Builder::INFTY, false), _graph(graph), _m(m) {}
-    int id(MutableLandscape::Node t, MutableLandscape::Arc a) {
-        const int id = _graph.id(t) * _m + _graph.id(a);
+    XVar(const MutableLandscape::Graph & graph,
+         std::vector<std::vector<int>> && targets_arcs)
+        : VarType(0, 0, OSI_Builder::INFTY, false)
+        , _graph(graph)
+        , _ids(std::move(targets_arcs)) {
+        _number = _ids.size();
+    }
+    bool contains(MutableLandscape::Node t, MutableLandscape::Arc a) const {
+        return _ids.contains(_graph.id(t), _graph.id(a));
+    }
+    const std::vector<int> & arcs(MutableLandscape::Node t) const {
+        return _ids.keys(_graph.id(t));
+    }
+    int id(MutableLandscape::Node t, MutableLandscape::Arc a) const {
+        const int id = _ids.id(_graph.id(t), _graph.id(a));
         assert(id >= 0 && id < _number);
         return _offset + id;
     }
@@ -20,18 +128,19 @@ public:
 class RestoredXVar : public OSI_Builder::VarType {
 private:
     const MutableLandscape::Graph & _graph;
-    int _nb_vars_by_node;
+    const SparseIds _ids;
 
 public:
-    RestoredXVar(const RestorationPlan<MutableLandscape> & plan, int n)
+    RestoredXVar(const MutableLandscape::Graph & graph,
+                 std::vector<std::vector<int>> && targets_elements)
         : VarType(0, 0, OSI_Builder::INFTY, false)
-        , _graph(plan.getLandscape().getNetwork()) {
-        _nb_vars_by_node = plan.getNbArcRestorationElements();
-        _number = n * _nb_vars_by_node;
+        , _graph(graph)
+        , _ids(std::move(targets_elements)) {
+        _number = _ids.size();
     }
     int id(MutableLandscape::Node t,
-           RestorationPlan<MutableLandscape>::ArcRestorationElement e) {
-        const int id = _graph.id(t) * _nb_vars_by_node + e.id;
+           RestorationPlan<MutableLandscape>::ArcRestorationElement e) const {
+        const int id = _ids.id(_graph.id(t), e.id);
         assert(id >= 0 && id < _number);
         return _offset + id;
     }
@@ -83,66 +192,42 @@ public:
     YVar y;
 
     Variables(const MutableLandscape & landscape,
-              const RestorationPlan<MutableLandscape> & plan)
+              const RestorationPlan<MutableLandscape> & plan,
+              std::vector<std::vector<int>> && targets_arcs)
         : graph(landscape.getNetwork())
         , n(lemon::countNodes(graph))
         , m(lemon::countArcs(graph))
-        , x(graph, n, m)
-        , restored_x(plan, n)
+        , x(graph, std::vector<std::vector<int>>(targets_arcs))
+        , restored_x(graph, compute_targets_arc_elements(landscape, plan,
+                                                         targets_arcs))
         , f(graph, n)
         , restored_f(plan)
         , y(plan) {}
-};
-
-void name_variables(OSI_Builder & solver, const MutableLandscape & landscape,
-                    const RestorationPlan<MutableLandscape> & plan,
-                    Variables & vars) {
-    const MutableLandscape::Graph & graph = landscape.getNetwork();
+    Variables(const MutableLandscape & landscape,
+              const RestorationPlan<MutableLandscape> & plan)
+        : Variables(landscape, plan, compute_targets_arcs(landscape, plan)) {}
 
-    auto node_str = [&graph](MutableLandscape::Node v) {
-        return std::to_string(graph.id(v));
-    };
-    auto arc_str = [&graph, &node_str](MutableLandscape::Arc a) {
-        return std::to_string(graph.id(a)) + "(" + node_str(graph.source(a)) +
-               "," + node_str(graph.target(a)) + ")";
-    };
+    /**
+     * @brief Number of x and restored_x columns of the dense indexing, that
+     * creates them for every (target, arc) pair.
+     */
+    std::size_t getNbDenseFlowVars(
+        const RestorationPlan<MutableLandscape> & plan) const {
+        return static_cast<std::size_t>(n) *
+               (m + plan.getNbArcRestorationElements());
+    }
+};
 
-    // XVar
-    for(MutableLandscape::NodeIt t(graph); t != lemon::INVALID; ++t)
-        for(MutableLandscape::ArcIt a(graph); a != lemon::INVALID; ++a)
-            solver.setColName(vars.x.id(t, a),
-                              "x_t_" + node_str(t) + "_a_" + arc_str(a));
-    // RestoredXVar
-    for(MutableLandscape::NodeIt t(graph); t != lemon::INVALID; ++t)
-        for(MutableLandscape::ArcIt a(graph); a != lemon::INVALID; ++a)
-            for(auto const & e : plan[a])
-                solver.setColName(vars.restored_x.id(t, e),
-                                  "restored_x_t_" + node_str(t) + "_a_" +
-                                      arc_str(a) + "_" +
-                                      std::to_string(e.option));
-    // FVar
-    for(MutableLandscape::NodeIt t(graph); t != lemon::INVALID; ++t)
-        solver.setColName(vars.f.id(t), "f_t_" + node_str(t));
-    // RestoredFVar
-    for(MutableLandscape::NodeIt t(graph); t != lemon::INVALID; ++t)
-        for(auto const & e : plan[t])
-            solver.setColName(
-                vars.restored_f.id(e),
-                "restored_f_t_" + node_str(t) + "_" + std::to_string(e.option));
-    // YVar
-    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
-        solver.setColName(vars.y.id(i), "y_" + std::to_string(i));
-}
 }  // namespace Solvers::PL_ECA_2_Vars
 
 using namespace Solvers::PL_ECA_2_Vars;
 
 void insert_variables(OSI_Builder & solver_builder, Variables & vars) {
-    solver_builder.addVarType(&vars.x);
-    solver_builder.addVarType(&vars.restored_x);
-    solver_builder.addVarType(&vars.f);
-    solver_builder.addVarType(&vars.restored_f);
-    solver_builder.addVarType(&vars.y);
+    solver_builder.addVarType(&vars.x.setName("x_"));
+    solver_builder.addVarType(&vars.restored_x.setName("restored_x_"));
+    solver_builder.addVarType(&vars.f.setName("f_"));
+    solver_builder.addVarType(&vars.restored_f.setName("restored_f_"));
+    solver_builder.addVarType(&vars.y.setName("y_"));
     solver_builder.init();
 }
 
@@ -160,7 +245,7 @@ void fill_solver(OSI_Builder & solver_builder,
     MutableLandscape::Graph::NodeMap<double> M(graph);
     std::for_each(std::execution::par, nodes.begin(), nodes.end(),
                   [&](MutableLandscape::Node t) {
-                      M[t] = max_flow_in(landscape, plan, t);
+                      M[t] = max_flow_in(landscape, plan, t, B);
                   });
 
     ////////////////////////////////////////////////////////////////////////
@@ -183,10 +268,17 @@ void fill_solver(OSI_Builder & solver_builder,
         if(landscape.getQuality(t) == 0 && !plan.contains(t)) continue;
         const int f_t = vars.f.id(t);
         // out_flow(u) - in_flow(u) <= w(u)
+        // only for the nodes reaching t, the others have no flow variables
+        std::vector<bool> reaches_t(graph.maxNodeId() + 1, false);
+        reaches_t[graph.id(t)] = true;
+        for(const int a_id : vars.x.arcs(t))
+            reaches_t[graph.id(graph.source(graph.arcFromId(a_id)))] = true;
         for(MutableLandscape::NodeIt u(graph); u != lemon::INVALID; ++u) {
+            if(!reaches_t[graph.id(u)]) continue;
             // out flow
             for(MutableLandscape::Graph::OutArcIt b(graph, u);
                 b != lemon::INVALID; ++b) {
+                if(!vars.x.contains(t, b)) continue;
                 const int x_tb = vars.x.id(t, b);
                 solver_builder.buffEntry(x_tb, 1);
                 for(auto const & e : plan[b]) {
@@ -197,6 +289,7 @@ void fill_solver(OSI_Builder & solver_builder,
             // in flow
             for(MutableLandscape::Graph::InArcIt a(graph, u);
                 a != lemon::INVALID; ++a) {
+                if(!vars.x.contains(t, a)) continue;
                 const int x_ta = vars.x.id(t, a);
                 solver_builder.buffEntry(x_ta, -landscape.getProbability(a));
                 for(auto const & e : plan[a]) {
@@ -218,7 +311,8 @@ void fill_solver(OSI_Builder & solver_builder,
         }
 
         // x_a < y_i * M
-        for(MutableLandscape::ArcIt a(graph); a != lemon::INVALID; ++a) {
+        for(const int a_id : vars.x.arcs(t)) {
+            const MutableLandscape::Arc a = graph.arcFromId(a_id);
             for(auto const & e : plan[a]) {
                 const int y_i = vars.y.id(e.option);
                 const int x_ta = vars.restored_x.id(t, e);
@@ -260,38 +354,84 @@ void fill_solver(OSI_Builder & solver_builder,
     }
 }
 
+/**
+ * @brief Computes the values of the variables corresponding to the options of
+ * start_solution, the flows being routed along the maximum probability paths.
+ */
+std::vector<double> compute_start_values(
+    const OSI_Builder & solver_builder, const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const Solution & start_solution, Variables & vars) {
+    const MutableLandscape::Graph & graph = landscape.getNetwork();
+    std::vector<double> values(solver_builder.getNbVars(), 0.0);
+    for(MutableLandscape::NodeIt t(graph); t != lemon::INVALID; ++t) {
+        if(landscape.getQuality(t) == 0 && !plan.contains(t)) continue;
+        const double f_t = max_probability_tree_flow(
+            landscape, plan, start_solution, t,
+            [&](MutableLandscape::Arc a,
+                const RestorationPlan<MutableLandscape>::ArcRestorationElement *
+                    e,
+                double flow) {
+                // the arcs that cannot carry flow have no variables, as the
+                // arcs of null probability in the best scenario that the tree
+                // may still use to reach t
+                if(flow <= 0 || !vars.x.contains(t, a)) return;
+                values[e == nullptr ? vars.x.id(t, a)
+                                    : vars.restored_x.id(t, *e)] = flow;
+            });
+        values[vars.f.id(t)] = f_t;
+        for(const auto & e : plan[t])
+            if(start_solution.contains(e.option))
+                values[vars.restored_f.id(e)] = f_t;
+    }
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        values[vars.y.id(i)] = start_solution[i];
+    return values;
+}
+
 Solution Solvers::PL_ECA_2::solve(
     const MutableLandscape & landscape,
     const RestorationPlan<MutableLandscape> & plan, const double B) const {
     Solution solution(landscape, plan);
     const int log_level = params.at("log")->getInt();
-    const int timeout = params.at("timeout")->getInt();
-    (void)timeout;  // pas bien
     const bool relaxed = params.at("relaxed")->getBool();
+    const int warm_start = params.at("warm_start")->getInt();
+    const Deadline deadline = makeDeadline();
     Chrono chrono;
     OSI_Builder solver_builder;
     Variables vars(landscape, plan);
     insert_variables(solver_builder, vars);
-    if(log_level > 0)
+    if(log_level > 0) {
+        const std::size_t nb_flow_vars =
+            vars.x.getNumber() + vars.restored_x.getNumber();
+        std::cout << name() << ": " << nb_flow_vars
+                  << " flow variables instead of "
+                  << vars.getNbDenseFlowVars(plan) << ", "
+                  << vars.getNbDenseFlowVars(plan) - nb_flow_vars
+                  << " saved" << std::endl;
         std::cout << name()
                   << ": Start filling solver : " << solver_builder.getNbVars()
                   << " variables" << std::endl;
+    }
     fill_solver(solver_builder, landscape, plan, B, vars, relaxed);
-   #define WITH_GUROBI
-#ifndef WITH_GUROBI
-    OsiSolverInterface * solver =
-        solver_builder.buildSolver<OsiClpSolverInterface>(OSI_Builder::MAX);
-    if(log_level <= 1) solver->setHintParam(OsiDoReducePrint);
+    std::vector<double> start_values;
+    if(warm_start != WarmStart::NONE) {
+        Chrono heuristic_chrono;
+        const Solution start_solution =
+            WarmStart::compute(warm_start, landscape, plan, B, log_level);
+        start_values = compute_start_values(solver_builder, landscape, plan,
+                                            start_solution, vars);
+        if(log_level >= 1)
+            std::cout << name() << ": Warm start computed in "
+                      << heuristic_chrono.timeMs() << " ms with ECA "
+                      << ECA().eval(Helper::decore_landscape(landscape, plan,
+                                                             start_solution))
+                      << std::endl;
+    }
     if(log_level >= 1) {
         if(log_level >= 3) {
-            name_variables(solver_builder, landscape, plan, preprocessed_datas,
-                           vars);
-            OsiClpSolverInterface * solver_clp =
-                solver_builder.buildSolver<OsiClpSolverInterface>(
-                    OSI_Builder::MAX);
-            solver_clp->writeLp("pl_eca_3");
-            delete solver_clp;
-            std::cout << name() << ": LP printed to 'pl_eca_3.lp'" << std::endl;
+            solver_builder.writeLp("pl_eca_2.lp", OSI_Builder::MAX, relaxed);
+            std::cout << name() << ": LP printed to 'pl_eca_2.lp'" << std::endl;
         }
         std::cout << name() << ": Complete filling solver : "
                   << solver_builder.getNbConstraints() << " constraints and "
@@ -299,35 +439,34 @@ Solution Solvers::PL_ECA_2::solve(
                   << chrono.lapTimeMs() << " ms" << std::endl;
         std::cout << name() << ": Start solving" << std::endl;
     }
-
-    solver->initialSolve();
-    CbcModel model(*solver);
-    model.setLogLevel(log_level - 1);
-    model.setNumberThreads(8);
-    CglFlowCover cut_flow;
-    model.addCutGenerator(&cut_flow, 1, "FlowCover");
-    CglMixedIntegerRounding2 cut_mir;
-    model.addCutGenerator(&cut_mir, 1, "MIR");
-    model.setAllowableGap(1e-10);
-    CbcMain0(model);
-    model.branchAndBound(1);
-    ////////////////////
-    const double * var_solution = model.bestSolution();
-    if(var_solution == nullptr) {
+    std::unique_ptr<MIPBackend::Backend> backend = MIPBackend::create(
+        params.at("backend")->getInt(), backendParams(deadline));
+    backend->load(solver_builder, OSI_Builder::MAX);
+    if(!start_values.empty()) backend->setStart(start_values);
+    if(!backend->solve()) {
         std::cerr << name() << ": Fail" << std::endl;
-        delete solver;
         throw "caca";
     }
+    if(log_level >= 1)
+        std::cout << name() << ": " << backend->name() << " stopped with bound "
+                  << backend->getBestBound() << " in " << chrono.lapTimeMs()
+                  << " ms" << (start_values.empty() ? " without" : " with")
+                  << " warm start" << std::endl;
+    const std::vector<double> & var_solution = backend->getSolution();
     for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
         const int y_i = vars.y.id(i);
         double value = var_solution[y_i];
         solution.set(i, value);
     }
     solution.setComputeTimeMs(chrono.timeMs());
-    solution.obj = model.getObjValue();
+    solution.obj = backend->getObjValue();
+    solution.bound = backend->getBestBound();
+    // the backend only stops early on its time limit
+    solution.status =
+        backend->isProvenOptimal() ? Solution::OPTIMAL : Solution::TIMEOUT;
     solution.nb_vars = solver_builder.getNbNonZeroVars();
     solution.nb_constraints = solver_builder.getNbConstraints();
-    solution.nb_elems = model.getNumElements();
+    solution.nb_elems = solver_builder.getNbElems();
     if(log_level >= 1) {
         std::cout << name()
                   << ": Complete solving : " << solution.getComputeTimeMs()
@@ -335,118 +474,7 @@ Solution Solvers::PL_ECA_2::solve(
         std::cout << name() << ": ECA from obj : " << std::sqrt(solution.obj)
                   << std::endl;
     }
-    delete solver;
-    return solution;
-#else
-    const int nb_vars = solver_builder.getNbVars();
-    double * objective = solver_builder.getObjective();
-    double * col_lb = solver_builder.getColLB();
-    double * col_ub = solver_builder.getColUB();
-    char * vtype = new char[nb_vars];
-    for(OSI_Builder::VarType * varType : solver_builder.getVarTypes()) {
-        const int offset = varType->getOffset();
-        const int last_id = varType->getOffset() + varType->getNumber() - 1;
-        for(int i = offset; i <= last_id; i++) {
-            vtype[i] = (!relaxed && varType->isInteger() ? GRB_BINARY
-                                                         : GRB_CONTINUOUS);
-        }
-    }
-
-    CoinPackedMatrix * matrix = solver_builder.getMatrix();
-    const int nb_rows = matrix->getNumRows();
-    const int nb_elems = matrix->getNumElements();
-    int * begins = new int[nb_rows];
-    std::copy(matrix->getVectorStarts(), matrix->getVectorStarts() + nb_rows,
-              begins);
-    int * indices = new int[nb_elems];
-    std::copy(matrix->getIndices(), matrix->getIndices() + nb_elems, indices);
-    double * elements = new double[nb_elems];
-    std::copy(matrix->getElements(), matrix->getElements() + nb_elems,
-              elements);
-    double * row_lb = solver_builder.getRowLB();
-    double * row_ub = solver_builder.getRowUB();
-
-    GRBenv * env = NULL;
-    GRBmodel * model = NULL;
-    GRBemptyenv(&env);
-    GRBstartenv(env);
-    ////////////////////
-    GRBsetdblparam(env, GRB_DBL_PAR_MIPGAP, 1e-8);
-    GRBsetintparam(env, GRB_INT_PAR_LOGTOCONSOLE, (log_level >= 2 ? 1 : 0));
-    GRBsetintparam(env, GRB_INT_PAR_THREADS, 8);
-    GRBsetdblparam(env, GRB_DBL_PAR_TIMELIMIT, timeout);
-    ////////////////////
-    GRBnewmodel(env, &model, "pl_eca_3", 0, NULL, NULL, NULL, NULL, NULL);
-    GRBaddvars(model, nb_vars, 0, NULL, NULL, NULL, objective, col_lb, col_ub,
-               vtype, NULL);
-    GRBaddrangeconstrs(model, nb_rows, nb_elems, begins, indices, elements,
-                       row_lb, row_ub, NULL);
-    ////////////////////
-    GRBsetintattr(model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
-
-    if(log_level >= 1) {
-        if(log_level >= 2) {
-            name_variables(solver_builder, landscape, plan, vars);
-            OsiClpSolverInterface * solver_clp =
-                solver_builder.buildSolver<OsiClpSolverInterface>(
-                    OSI_Builder::MAX);
-            solver_clp->writeLp("pl_eca_3");
-            delete solver_clp;
-            std::cout << name() << ": LP printed to 'pl_eca_3.lp'" << std::endl;
-        }
-        std::cout << name() << ": Complete filling solver : "
-                  << solver_builder.getNbConstraints() << " constraints and "
-                  << solver_builder.getNbElems() << " entries in "
-                  << chrono.lapTimeMs() << " ms" << std::endl;
-        std::cout << name() << ": Start solving" << std::endl;
-    }
-
-    GRBoptimize(model);
-    ////////////////////
-    int status;
-    GRBgetintattr(model, GRB_INT_ATTR_STATUS, &status);
-    if(status == GRB_INF_OR_UNBD) {
-        std::cout << "Model is infeasible or unbounded" << std::endl;
-    } else if(status != GRB_OPTIMAL) {
-        std::cout << "Optimization was stopped early" << std::endl;
-    }
-    double obj;
-    GRBgetdblattr(model, GRB_DBL_ATTR_OBJVAL, &obj);
-    double * var_solution = new double[nb_vars];
-    GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, nb_vars, var_solution);
-    if(var_solution == nullptr) {
-        std::cerr << name() << ": Fail" << std::endl;
-        assert(false);
-    }
-    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
-        const int y_i = vars.y.id(i);
-        double value = var_solution[y_i];
-        solution.set(i, value);
-    }
-    solution.setComputeTimeMs(chrono.timeMs());
-    solution.obj = obj;
-    solution.nb_vars = solver_builder.getNbNonZeroVars();
-    solution.nb_constraints = solver_builder.getNbConstraints();
-    solution.nb_elems = nb_elems;
-    if(log_level >= 1) {
-        std::cout << name()
-                  << ": Complete solving : " << solution.getComputeTimeMs()
-                  << " ms" << std::endl;
-        std::cout << name() << ": ECA from obj : " << std::sqrt(solution.obj)
-                  << std::endl;
-    }
-
-    GRBfreemodel(model);
-    GRBfreeenv(env);
-
-    delete[] vtype;
-    delete[] begins;
-    delete[] indices;
-    delete[] elements;
-    delete[] var_solution;
-
     return solution;
-#endif
 }
 
 double Solvers::PL_ECA_2::eval(const MutableLandscape & landscape,
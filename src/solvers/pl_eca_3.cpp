@@ -1,330 +1,372 @@
 #include "solvers/pl_eca_3.hpp"
 
-#include "CglFlowCover.hpp"
-#include "CglMixedIntegerRounding2.hpp"
-#include "gurobi_c.h"
+#include <tuple>
 
-namespace Solvers::PL_ECA_3_Vars {
-class PreprocessedDatas {
-public:
-    std::vector<MutableLandscape::Node> target_nodes;
-    std::unique_ptr<
-        MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>>>
-        contracted_instances;
-    MutableLandscape::Graph::NodeMap<StaticLandscape::Graph::NodeMap<double> *>
-        M_Maps_Map;
-
-    PreprocessedDatas(const MutableLandscape & landscape,
-                      const RestorationPlan<MutableLandscape> & plan)
-        : M_Maps_Map(landscape.getNetwork()) {
-        const MutableLandscape::Graph & graph = landscape.getNetwork();
-        // target_nodes
-        for(MutableLandscape::NodeIt u(graph); u != lemon::INVALID; ++u) {
-            if(landscape.getQuality(u) == 0 && !plan.contains(u)) continue;
-            target_nodes.push_back(u);
-        }
-        // contracted_instances
-        MyContractionAlgorithm alg2;
-        contracted_instances = alg2.precompute(landscape, plan, target_nodes);
-        // M_Maps_Map
-        std::for_each(
-            std::execution::par, target_nodes.begin(), target_nodes.end(),
-            [&](MutableLandscape::Node t) {
-                const ContractionResult & cr = *(*contracted_instances)[t];
-                const StaticLandscape & contracted_landscape = cr.landscape;
-                const StaticLandscape::Graph & contracted_graph =
-                    contracted_landscape.getNetwork();
-                const RestorationPlan<StaticLandscape> & contracted_plan =
-                    cr.plan;
-
-                M_Maps_Map[t] = new StaticLandscape::Graph::NodeMap<double>(
-                    contracted_graph);
-                StaticLandscape::Graph::NodeMap<double> & M_Map =
-                    *M_Maps_Map[t];
-                for(StaticLandscape::NodeIt v(contracted_graph);
-                    v != lemon::INVALID; ++v)
-                    M_Map[v] =
-                        max_flow_in(contracted_landscape, contracted_plan, v);
-            });
-    }
-    ~PreprocessedDatas() {
-        for(MutableLandscape::Node v : target_nodes) delete M_Maps_Map[v];
-    }
-};
-
-class XVar : public OSI_Builder::VarType {
-private:
-    const ContractionResult & _cr;
-
-public:
-    XVar(const ContractionResult & cr)
-        : VarType(lemon::countArcs(cr.landscape.getNetwork())), _cr(cr) {}
-    int id(StaticLandscape::Arc a) const {
-        const int id = _cr.landscape.getNetwork().id(a);
-        assert(id >= 0 && id < _number);
-        return _offset + id;
-    }
-};
-class RestoredXVar : public OSI_Builder::VarType {
-public:
-    RestoredXVar(const ContractionResult & cr)
-        : VarType(cr.plan.getNbArcRestorationElements()) {}
-    int id(RestorationPlan<StaticLandscape>::ArcRestorationElement e) const {
-        assert(e.id >= 0 && e.id < _number);
-        return _offset + e.id;
-    }
-};
-class FVar : public OSI_Builder::VarType {
-public:
-    FVar() : VarType(1) {}
-    int id() const { return _offset; }
-};
-class RestoredFVar : public OSI_Builder::VarType {
-public:
-    RestoredFVar(const ContractionResult & cr)
-        : VarType(cr.plan.getNbNodeRestorationElements()) {}
-    int id(RestorationPlan<MutableLandscape>::NodeRestorationElement e) const {
-        assert(e.id >= 0 && e.id < _number);
-        return _offset + e.id;
-    }
-};
-class YVar : public OSI_Builder::VarType {
-public:
-    YVar(const RestorationPlan<MutableLandscape> & plan)
-        : VarType(plan.getNbOptions(), 0, 1, true) {}
-    int id(RestorationPlan<MutableLandscape>::Option option) const {
-        const int id = option;
-        assert(id >= 0 && id < _number);
-        return _offset + id;
-    }
-};
-
-class ContractedVars {
-public:
-    XVar x;
-    RestoredXVar restored_x;
-    FVar f;
-    RestoredFVar restored_f;
-    ContractedVars(const ContractionResult & cr)
-        : x(cr), restored_x(cr), f(), restored_f(cr){};
-};
-
-class Variables {
-public:
-    MutableLandscape::Graph::NodeMap<ContractedVars *> contracted;
-    YVar y;
-    const PreprocessedDatas & _pdatas;
-    Variables(const MutableLandscape & landscape,
-              const RestorationPlan<MutableLandscape> & plan,
-              PreprocessedDatas & pdatas)
-        : contracted(landscape.getNetwork(), nullptr)
-        , y(plan)
-        , _pdatas(pdatas) {
-        for(MutableLandscape::Node v : pdatas.target_nodes)
-            contracted[v] =
-                new ContractedVars(*(*pdatas.contracted_instances)[v]);
-    }
-    ~Variables() {
-        for(MutableLandscape::Node v : _pdatas.target_nodes)
-            delete contracted[v];
-    }
-    ContractedVars & operator[](MutableLandscape::Node t) const {
-        return *contracted[t];
-    }
-};
-
-void name_variables(OSI_Builder & solver, const MutableLandscape & landscape,
-                    const RestorationPlan<MutableLandscape> & plan,
-                    PreprocessedDatas & pdatas, const Variables & vars) {
-    const MutableLandscape::Graph & graph = landscape.getNetwork();
-    auto node_str = [&graph](MutableLandscape::Node v) {
-        return std::to_string(graph.id(v));
-    };
-    // XVar
-    for(MutableLandscape::Node t : pdatas.target_nodes) {
-        const ContractedVars & cvars = vars[t];
-        const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
-        const StaticLandscape & contracted_landscape = cr.landscape;
-        const StaticLandscape::Graph & contracted_graph =
-            contracted_landscape.getNetwork();
-        const RestorationPlan<StaticLandscape> & contracted_plan = cr.plan;
-        for(StaticLandscape::ArcIt a(contracted_graph); a != lemon::INVALID;
-            ++a) {
-            // solver->setColName(x_var->id(a), "x_t_" + node_str(t) + "_a_" +
-            // std::to_string(contracted_graph.id(a)));
-            solver.setColName(
-                cvars.x.id(a),
-                "x_t_" + node_str(t) + "(" +
-                    std::to_string(contracted_graph.id(cr.t)) + ")_a_" +
-                    std::to_string(contracted_graph.id(a)) + "(" +
-                    std::to_string(
-                        contracted_graph.id(contracted_graph.source(a))) +
-                    "," +
-                    std::to_string(
-                        contracted_graph.id(contracted_graph.target(a))) +
-                    ")");
-            // RestoredXVar
-            for(auto const & e : contracted_plan[a])
-                solver.setColName(cvars.restored_x.id(e),
-                                  "restored_x_t_" + node_str(t) + "_a_" +
-                                      std::to_string(contracted_graph.id(a)) +
-                                      "_" + std::to_string(e.option));
-        }
-    }
-    // FVar
-    for(MutableLandscape::Node t : pdatas.target_nodes)
-        solver.setColName(vars[t].f.id(), "f_t_" + node_str(t));
-    // RestoredFVar
-    for(MutableLandscape::Node t : pdatas.target_nodes)
-        for(auto const & e : plan[t])
-            solver.setColName(
-                vars[t].restored_f.id(e),
-                "restored_f_t_" + node_str(t) + "_" + std::to_string(e.option));
-    // YVar
-    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
-        solver.setColName(vars.y.id(i), "y_" + std::to_string(i));
-}
-}  // namespace Solvers::PL_ECA_3_Vars
+#include "solvers/pl_eca_3_vars.hpp"
+#include "solvers/warm_start.hpp"
 
 using namespace Solvers::PL_ECA_3_Vars;
 
 void insert_variables(OSI_Builder & solver_builder, Variables & vars,
                       PreprocessedDatas & pdatas) {
+    int k = 0;
     for(MutableLandscape::Node t : pdatas.target_nodes) {
-        solver_builder.addVarType(&vars[t].x);
-        solver_builder.addVarType(&vars[t].restored_x);
-        solver_builder.addVarType(&vars[t].f);
-        solver_builder.addVarType(&vars[t].restored_f);
+        const std::string t_str = std::to_string(k++);
+        solver_builder.addVarType(&vars[t].x.setName("x_t" + t_str + "_a"));
+        solver_builder.addVarType(
+            &vars[t].restored_x.setName("restored_x_t" + t_str + "_e"));
+        solver_builder.addVarType(&vars[t].f.setName("f_t" + t_str + "_"));
+        solver_builder.addVarType(
+            &vars[t].restored_f.setName("restored_f_t" + t_str + "_e"));
     }
-    solver_builder.addVarType(&vars.y);
+    solver_builder.addVarType(&vars.y.setName("y_"));
     solver_builder.init();
 }
 
-void fill_solver(OSI_Builder & solver_builder,
-                 const MutableLandscape & landscape,
-                 const RestorationPlan<MutableLandscape> & plan, const double B,
-                 Variables & vars, PreprocessedDatas & pdatas) {
-    for(MutableLandscape::Node t : pdatas.target_nodes) {
-        ContractionResult & cr = *(*pdatas.contracted_instances)[t];
-        cr.plan.initElementIDs();
-    }
-
-    auto M_x_const = [&](MutableLandscape::Node t, StaticLandscape::Arc a) {
-        const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
-        const StaticLandscape::Graph & contracted_graph =
-            cr.landscape.getNetwork();
-        return (*pdatas.M_Maps_Map[t])[contracted_graph.source(a)];
-    };
-    auto M_f_const = [&](MutableLandscape::Node t) {
-        const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
-        return (*pdatas.M_Maps_Map[t])[cr.t];
-    };
+void Solvers::PL_ECA_3_Vars::fill_target(
+    OSI_Builder & solver_builder, const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, MutableLandscape::Node t,
+    const ContractedVars & cvars, const YVar & y,
+    const PreprocessedDatas & pdatas) {
+    const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+    const StaticLandscape & contracted_landscape = cr.landscape;
+    const StaticLandscape::Graph & contracted_graph =
+        contracted_landscape.getNetwork();
+    const RestorationPlan<StaticLandscape> & contracted_plan = cr.plan;
+    const StaticLandscape::Graph::NodeMap<double> & M_Map =
+        *pdatas.M_Maps_Map[t];
+    const int f_t = cvars.f.id();
     ////////////////////////////////////////////////////////////////////////
     // Columns : Objective
     ////////////////////
-    for(MutableLandscape::Node t : pdatas.target_nodes) {
-        // sum w(t) * f_t
-        const int f_t = vars[t].f.id();
-        solver_builder.setObjective(f_t, landscape.getQuality(t));
-        for(auto const & e : plan[t]) {
-            const int restored_f_t = vars[t].restored_f.id(e);
-            solver_builder.setObjective(restored_f_t, e.quality_gain);
-        }
+    // w(t) * f_t
+    solver_builder.setObjective(f_t, landscape.getQuality(t));
+    for(auto const & e : plan[t]) {
+        const int restored_f_t = cvars.restored_f.id(e);
+        solver_builder.setObjective(restored_f_t, e.quality_gain);
     }
     ////////////////////////////////////////////////////////////////////////
     // Rows : Constraints
     ////////////////////
-    for(MutableLandscape::Node t : pdatas.target_nodes) {
-        const ContractedVars & cvars = vars[t];
-        const int f_t = cvars.f.id();
-        const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
-        const StaticLandscape & contracted_landscape = cr.landscape;
-        const StaticLandscape::Graph & contracted_graph =
-            contracted_landscape.getNetwork();
-        const RestorationPlan<StaticLandscape> & contracted_plan = cr.plan;
-        // out_flow(u) - in_flow(u) <= w(u)
-        for(StaticLandscape::NodeIt u(contracted_graph); u != lemon::INVALID;
-            ++u) {
-            // out flow
-            for(StaticLandscape::Graph::OutArcIt b(contracted_graph, u);
-                b != lemon::INVALID; ++b) {
-                const int x_tb = cvars.x.id(b);
-                solver_builder.buffEntry(x_tb, 1);
-                for(auto const & e : contracted_plan[b]) {
-                    const int restored_x_t_b = cvars.restored_x.id(e);
-                    solver_builder.buffEntry(restored_x_t_b, 1);
-                }
-            }
-            // in flow
-            for(StaticLandscape::Graph::InArcIt a(contracted_graph, u);
-                a != lemon::INVALID; ++a) {
-                const int x_ta = cvars.x.id(a);
-                solver_builder.buffEntry(
-                    x_ta, -contracted_landscape.getProbability(a));
-                for(auto const & e : contracted_plan[a]) {
-                    const int degraded_x_t_a = cvars.restored_x.id(e);
-                    solver_builder.buffEntry(degraded_x_t_a,
-                                             -e.restored_probability);
-                }
-            }
-            // optional injected flow
-            for(auto const & e : contracted_plan[u]) {
-                const int y_u = vars.y.id(e.option);
-                solver_builder.buffEntry(y_u, -e.quality_gain);
+    // out_flow(u) - in_flow(u) <= w(u)
+    for(StaticLandscape::NodeIt u(contracted_graph); u != lemon::INVALID; ++u) {
+        // out flow
+        for(StaticLandscape::Graph::OutArcIt b(contracted_graph, u);
+            b != lemon::INVALID; ++b) {
+            const int x_tb = cvars.x.id(b);
+            solver_builder.buffEntry(x_tb, 1);
+            for(auto const & e : contracted_plan[b]) {
+                const int restored_x_t_b = cvars.restored_x.id(e);
+                solver_builder.buffEntry(restored_x_t_b, 1);
             }
-            // optimisation variable
-            if(u == cr.t) solver_builder.buffEntry(f_t, 1);
-            // injected flow
-            solver_builder.pushRow(-OSI_Builder::INFTY,
-                                   contracted_landscape.getQuality(u));
         }
-        // restored_x_a < y_i * M
-        for(StaticLandscape::ArcIt a(contracted_graph); a != lemon::INVALID;
-            ++a) {
+        // in flow
+        for(StaticLandscape::Graph::InArcIt a(contracted_graph, u);
+            a != lemon::INVALID; ++a) {
+            const int x_ta = cvars.x.id(a);
+            solver_builder.buffEntry(x_ta,
+                                     -contracted_landscape.getProbability(a));
             for(auto const & e : contracted_plan[a]) {
-                const int y_i = vars.y.id(e.option);
-                const int x_ta = cvars.restored_x.id(e);
-                solver_builder.buffEntry(y_i, M_x_const(t, a));
-                solver_builder.buffEntry(x_ta, -1);
-                solver_builder.pushRow(0, OSI_Builder::INFTY);
+                const int degraded_x_t_a = cvars.restored_x.id(e);
+                solver_builder.buffEntry(degraded_x_t_a,
+                                         -e.restored_probability);
             }
         }
-        // restored_f_t <= f_t
-        // restored_f_t <= y_i * M
-        for(const auto & e : plan[t]) {
-            const int y_i = vars.y.id(e.option);
-            const int restored_f_t = cvars.restored_f.id(e);
-            solver_builder.buffEntry(f_t, 1);
-            solver_builder.buffEntry(restored_f_t, -1);
-            solver_builder.pushRow(0, OSI_Builder::INFTY);
-
-            solver_builder.buffEntry(y_i, M_f_const(t));
-            solver_builder.buffEntry(restored_f_t, -1);
+        // optional injected flow
+        for(auto const & e : contracted_plan[u]) {
+            const int y_u = y.id(e.option);
+            solver_builder.buffEntry(y_u, -e.quality_gain);
+        }
+        // optimisation variable
+        if(u == cr.t) solver_builder.buffEntry(f_t, 1);
+        // injected flow
+        solver_builder.pushRow(-OSI_Builder::INFTY,
+                               contracted_landscape.getQuality(u));
+    }
+    // restored_x_a < y_i * M
+    for(StaticLandscape::ArcIt a(contracted_graph); a != lemon::INVALID; ++a) {
+        for(auto const & e : contracted_plan[a]) {
+            const int y_i = y.id(e.option);
+            const int x_ta = cvars.restored_x.id(e);
+            solver_builder.buffEntry(y_i,
+                                     M_Map[contracted_graph.source(a)]);
+            solver_builder.buffEntry(x_ta, -1);
             solver_builder.pushRow(0, OSI_Builder::INFTY);
         }
     }
+    // restored_f_t <= f_t
+    // restored_f_t <= y_i * M
+    for(const auto & e : plan[t]) {
+        const int y_i = y.id(e.option);
+        const int restored_f_t = cvars.restored_f.id(e);
+        solver_builder.buffEntry(f_t, 1);
+        solver_builder.buffEntry(restored_f_t, -1);
+        solver_builder.pushRow(0, OSI_Builder::INFTY);
+
+        solver_builder.buffEntry(y_i, M_Map[cr.t]);
+        solver_builder.buffEntry(restored_f_t, -1);
+        solver_builder.pushRow(0, OSI_Builder::INFTY);
+    }
+}
+
+std::vector<RestorationPlan<MutableLandscape>::Option>
+Solvers::PL_ECA_3_Vars::relevant_options(
+    const RestorationPlan<MutableLandscape> & plan, MutableLandscape::Node t,
+    const PreprocessedDatas & pdatas) {
+    const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+    const StaticLandscape::Graph & contracted_graph =
+        cr.landscape.getNetwork();
+    std::vector<bool> relevant(plan.getNbOptions(), false);
+    for(StaticLandscape::NodeIt u(contracted_graph); u != lemon::INVALID; ++u)
+        for(const auto & e : cr.plan[u]) relevant[e.option] = true;
+    for(StaticLandscape::ArcIt a(contracted_graph); a != lemon::INVALID; ++a)
+        for(const auto & e : cr.plan[a]) relevant[e.option] = true;
+    for(const auto & e : plan[t]) relevant[e.option] = true;
+
+    std::vector<RestorationPlan<MutableLandscape>::Option> options;
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        if(relevant[i]) options.push_back(i);
+    return options;
+}
+
+/**
+ * @return the index of the budget row, that is pushed last
+ */
+int fill_solver(OSI_Builder & solver_builder,
+                const MutableLandscape & landscape,
+                const RestorationPlan<MutableLandscape> & plan, const double B,
+                Variables & vars, PreprocessedDatas & pdatas) {
+    for(MutableLandscape::Node t : pdatas.target_nodes)
+        fill_target(solver_builder, landscape, plan, t, vars[t], vars.y,
+                    pdatas);
     ////////////////////
     // sum y_i < B
     for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
         const int y_i = vars.y.id(i);
         solver_builder.buffEntry(y_i, plan.getCost(i));
     }
-    solver_builder.pushRow(0, B);
+    // one sided for its upper bound to be modifiable by the backends
+    const int budget_row = solver_builder.getNbConstraints();
+    solver_builder.pushRow(-OSI_Builder::INFTY, B);
+    return budget_row;
+}
+
+/**
+ * @brief Sets in values the variables of target t corresponding to the options
+ * of start_solution, the flows being routed along the maximum probability
+ * paths of its contracted instance.
+ *
+ * @return the flow reaching t
+ */
+double fill_target_start_values(std::vector<double> & values,
+                                const RestorationPlan<MutableLandscape> & plan,
+                                MutableLandscape::Node t,
+                                const ContractedVars & cvars,
+                                const Solution & start_solution,
+                                const PreprocessedDatas & pdatas) {
+    const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+    const double f_t = max_probability_tree_flow(
+        cr.landscape, cr.plan, start_solution, cr.t,
+        [&](StaticLandscape::Arc a,
+            const RestorationPlan<StaticLandscape>::ArcRestorationElement * e,
+            double flow) {
+            values[e == nullptr ? cvars.x.id(a) : cvars.restored_x.id(*e)] =
+                flow;
+        });
+    values[cvars.f.id()] = f_t;
+    for(const auto & e : plan[t])
+        if(start_solution.contains(e.option))
+            values[cvars.restored_f.id(e)] = f_t;
+    return f_t;
+}
+
+/**
+ * @brief Computes the values of the variables corresponding to the options of
+ * start_solution, the flows being routed along the maximum probability paths
+ * of each contracted instance.
+ */
+std::vector<double> compute_start_values(
+    const OSI_Builder & solver_builder,
+    const RestorationPlan<MutableLandscape> & plan,
+    const Solution & start_solution, Variables & vars,
+    PreprocessedDatas & pdatas) {
+    std::vector<double> values(solver_builder.getNbVars(), 0.0);
+    for(MutableLandscape::Node t : pdatas.target_nodes)
+        fill_target_start_values(values, plan, t, vars[t], start_solution,
+                                 pdatas);
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        values[vars.y.id(i)] = start_solution[i];
+    return values;
+}
+
+/**
+ * @brief Reduced cost fixing of the options from the LP relaxation of the
+ * model, the incumbent being of value incumbent_value.
+ *
+ * @return the number of options newly fixed in fixed_options
+ */
+int fix_options_by_reduced_costs(const MutableLandscape & landscape,
+                                 const RestorationPlan<MutableLandscape> & plan,
+                                 const double B,
+                                 PreprocessedDatas & preprocessed_datas,
+                                 const double incumbent_value,
+                                 std::vector<int> & fixed_options) {
+    OSI_Builder solver_builder = OSI_Builder();
+    Variables vars(landscape, plan, preprocessed_datas);
+    insert_variables(solver_builder, vars, preprocessed_datas);
+    fill_solver(solver_builder, landscape, plan, B, vars, preprocessed_datas);
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
+        if(fixed_options[i] < 0) continue;
+        solver_builder.setBounds(vars.y.id(i), fixed_options[i],
+                                 fixed_options[i]);
+    }
+    // minimizes the opposite value for the reduced costs to be the usual ones
+    double * objective = solver_builder.getObjective();
+    std::transform(objective, objective + solver_builder.getNbVars(),
+                   objective, std::negate<double>());
+    OsiSolverInterface * solver =
+        solver_builder.buildSolver<OsiClpSolverInterface>(OSI_Builder::MIN,
+                                                           true);
+    solver->setHintParam(OsiDoReducePrint);
+    solver->messageHandler()->setLogLevel(0);
+    solver->initialSolve();
+    if(!solver->isProvenOptimal()) {
+        delete solver;
+        return 0;
+    }
+    const double * var_solution = solver->getColSolution();
+    const double * reduced_costs = solver->getReducedCost();
+    std::vector<double> y_values(plan.getNbOptions());
+    std::vector<double> y_reduced_costs(plan.getNbOptions());
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
+        y_values[i] = var_solution[vars.y.id(i)];
+        y_reduced_costs[i] = -reduced_costs[vars.y.id(i)];
+    }
+    const int nb_fixed =
+        reduced_cost_fixing(y_values, y_reduced_costs, -solver->getObjValue(),
+                            incumbent_value, fixed_options);
+    delete solver;
+    return nb_fixed;
 }
 
 Solution Solvers::PL_ECA_3::solve(
     const MutableLandscape & landscape,
     const RestorationPlan<MutableLandscape> & plan, const double B) const {
+    if(params.at("lazy")->getInt() > 0) return solveLazy(landscape, plan, B);
+    const int log_level = params.at("log")->getInt();
+    const int presolve = params.at("presolve")->getInt();
+    const Deadline deadline = makeDeadline();
+    std::vector<int> fixed_options(plan.getNbOptions(), -1);
+    int preprocessing_time;
+    // the presolve does not preserve the LP relaxation
+    if(presolve == 0 || params.at("relaxed")->getBool()) {
+        const std::unique_ptr<PreprocessedDatas> preprocessed_datas =
+            preprocess(landscape, plan, B, preprocessing_time);
+        return solveModel(landscape, plan, B, fixed_options,
+                          *preprocessed_datas, preprocessing_time, deadline);
+    }
+    Chrono chrono;
+    RestorationPlan<MutableLandscape> presolved_plan(landscape);
+    copy_options(plan, presolved_plan);
+    const int nb_over_budget = remove_over_budget_options(presolved_plan, B);
+    const int nb_dominated = remove_dominated_options(presolved_plan);
+    int presolve_time = chrono.lapTimeMs();
+    // shared by the reduced costs fixing and the model, the options removed
+    // by the fixing being fixed to 0 in the model
+    const std::unique_ptr<PreprocessedDatas> preprocessed_datas =
+        preprocess(landscape, presolved_plan, B, preprocessing_time);
+    chrono.lapTimeMs();
+    Solution incumbent(landscape, plan);
+    double incumbent_value = 0.0;
+    int nb_fixed = 0;
+    if(presolve >= 2) {
+        const Solution greedy_solution =
+            WarmStart::compute(WarmStart::GLUTTON_ECA_INC, landscape,
+                               presolved_plan, B, log_level);
+        for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+            incumbent.set(i, greedy_solution[i]);
+        incumbent_value = std::pow(
+            ECA().eval(Helper::decore_landscape(landscape, plan, incumbent)),
+            2);
+        nb_fixed = fix_options_by_reduced_costs(
+            landscape, presolved_plan, B, *preprocessed_datas, incumbent_value,
+            fixed_options);
+        std::vector<bool> removed(plan.getNbOptions());
+        for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+            removed[i] = (fixed_options[i] == 0);
+        remove_options(presolved_plan, removed);
+    }
+    // the emptied options only appear in the budget row
+    const auto compiled_presolved_plan = presolved_plan.compile();
+    const auto & nodeOptions = compiled_presolved_plan.getNodeOptionsMap();
+    const auto & arcOptions = compiled_presolved_plan.getArcOptionsMap();
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        if(nodeOptions[i].empty() && arcOptions[i].empty())
+            fixed_options[i] = 0;
+    presolve_time += chrono.lapTimeMs();
+    if(log_level > 0)
+        std::cout << name() << ": Presolve : " << nb_over_budget
+                  << " options over budget, " << nb_dominated
+                  << " dominated options, " << nb_fixed
+                  << " options fixed by reduced costs in " << presolve_time
+                  << " ms" << std::endl;
+
+    const Solution presolved_solution = solveModel(
+        landscape, presolved_plan, B, fixed_options, *preprocessed_datas,
+        preprocessing_time, deadline);
+    // presolved_solution refers to presolved_plan
     Solution solution(landscape, plan);
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        solution.set(i, presolved_solution[i]);
+    solution.setComputeTimeMs(presolved_solution.getComputeTimeMs() +
+                              presolve_time);
+    solution.preprocessing_time =
+        presolved_solution.preprocessing_time + presolve_time;
+    solution.obj = presolved_solution.obj;
+    solution.bound = presolved_solution.bound;
+    solution.status = presolved_solution.status;
+    solution.nb_vars = presolved_solution.nb_vars;
+    solution.nb_constraints = presolved_solution.nb_constraints;
+    solution.nb_elems = presolved_solution.nb_elems;
+    // the fixings only hold for the solutions better than the incumbent
+    if(presolve >= 2 && solution.obj < incumbent_value) {
+        for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+            solution.set(i, incumbent[i]);
+        solution.obj = incumbent_value;
+    }
+    return solution;
+}
+
+std::unique_ptr<PreprocessedDatas> Solvers::PL_ECA_3::preprocess(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B,
+    int & preprocessing_time) const {
     const int log_level = params.at("log")->getInt();
-    const int timeout = params.at("timeout")->getInt();
-    (void)timeout;  // pas bien
-    const bool relaxed = params.at("relaxed")->getBool();
     Chrono chrono;
     if(log_level > 0)
         std::cout << name() << ": Start preprocessing" << std::endl;
-    PreprocessedDatas preprocessed_datas(landscape, plan);
-    solution.preprocessing_time = chrono.lapTimeMs();
+    auto preprocessed_datas =
+        std::make_unique<PreprocessedDatas>(landscape, plan, M_budget(B));
+    preprocessing_time = chrono.timeMs();
+    if(log_level > 0)
+        std::cout << name() << ": " << preprocessed_datas->target_nodes.size()
+                  << " targets contracted in " << preprocessing_time << " ms"
+                  << std::endl;
+    return preprocessed_datas;
+}
+
+Solution Solvers::PL_ECA_3::solveModel(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B,
+    const std::vector<int> & fixed_options,
+    PreprocessedDatas & preprocessed_datas, const int preprocessing_time,
+    const Deadline & deadline) const {
+    Solution solution(landscape, plan);
+    const int log_level = params.at("log")->getInt();
+    const bool relaxed = params.at("relaxed")->getBool();
+    const int warm_start = params.at("warm_start")->getInt();
+    Chrono chrono;
+    solution.preprocessing_time = preprocessing_time;
     OSI_Builder solver_builder = OSI_Builder();
     Variables vars(landscape, plan, preprocessed_datas);
     insert_variables(solver_builder, vars, preprocessed_datas);
@@ -337,20 +379,61 @@ Solution Solvers::PL_ECA_3::solve(
                   << " variables" << std::endl;
     }
     fill_solver(solver_builder, landscape, plan, B, vars, preprocessed_datas);
-#define WITH_GUROBI
-#ifndef WITH_GUROBI
-    OsiSolverInterface * solver =
-        solver_builder.buildSolver<OsiClpSolverInterface>(OSI_Builder::MAX);
-    if(log_level <= 1) solver->setHintParam(OsiDoReducePrint);
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
+        if(fixed_options[i] < 0) continue;
+        solver_builder.setBounds(vars.y.id(i), fixed_options[i],
+                                 fixed_options[i]);
+    }
+    if(log_level >= 2) {
+        // root relaxation, to compare the big-M bounds
+        OsiSolverInterface * relaxed_solver =
+            solver_builder.buildSolver<OsiClpSolverInterface>(OSI_Builder::MAX,
+                                                               true);
+        relaxed_solver->setHintParam(OsiDoReducePrint);
+        relaxed_solver->messageHandler()->setLogLevel(0);
+        relaxed_solver->initialSolve();
+        std::cout << name() << ": LP relaxation : "
+                  << relaxed_solver->getObjValue() << " (tight_M "
+                  << params.at("tight_M")->getBool() << ")" << std::endl;
+        delete relaxed_solver;
+    }
+    std::vector<double> start_values;
+    double start_eca = 0.0;
+    if(warm_start != WarmStart::NONE) {
+        Chrono heuristic_chrono;
+        const Solution start_solution =
+            WarmStart::compute(warm_start, landscape, plan, B, log_level);
+        start_values = compute_start_values(solver_builder, plan,
+                                            start_solution, vars,
+                                            preprocessed_datas);
+        start_eca = ECA().eval(
+            Helper::decore_landscape(landscape, plan, start_solution));
+        if(log_level >= 1)
+            std::cout << name() << ": Warm start computed in "
+                      << heuristic_chrono.timeMs() << " ms with ECA "
+                      << start_eca << std::endl;
+    }
+    // the incumbents published by the concurrent solvers of a Portfolio
+    auto shared_start_values = [&](const std::vector<double> & coefs) {
+        Solution shared_solution(landscape, plan);
+        for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+            shared_solution.set(i, coefs[i]);
+        return compute_start_values(solver_builder, plan, shared_solution,
+                                    vars, preprocessed_datas);
+    };
+    const bool shared = incumbent_store != nullptr && !relaxed;
+    double shared_eca = start_eca;
+    if(shared && incumbent_store->getBestValue() > start_eca) {
+        std::vector<double> coefs;
+        std::tie(shared_eca, coefs) = incumbent_store->getBest();
+        start_values = shared_start_values(coefs);
+        if(log_level >= 1)
+            std::cout << name() << ": Warm start from the shared incumbent"
+                      << std::endl;
+    }
     if(log_level >= 1) {
         if(log_level >= 3) {
-            name_variables(solver_builder, landscape, plan, preprocessed_datas,
-                           vars);
-            OsiClpSolverInterface * solver_clp =
-                solver_builder.buildSolver<OsiClpSolverInterface>(
-                    OSI_Builder::MAX);
-            solver_clp->writeLp("pl_eca_3");
-            delete solver_clp;
+            solver_builder.writeLp("pl_eca_3.lp", OSI_Builder::MAX, relaxed);
             std::cout << name() << ": LP printed to 'pl_eca_3.lp'" << std::endl;
         }
         std::cout << name() << ": Complete filling solver : "
@@ -359,35 +442,62 @@ Solution Solvers::PL_ECA_3::solve(
                   << chrono.lapTimeMs() << " ms" << std::endl;
         std::cout << name() << ": Start solving" << std::endl;
     }
-
-    solver->initialSolve();
-    CbcModel model(*solver);
-    model.setLogLevel(log_level - 1);
-    model.setNumberThreads(8);
-    CglFlowCover cut_flow;
-    model.addCutGenerator(&cut_flow, 1, "FlowCover");
-    CglMixedIntegerRounding2 cut_mir;
-    model.addCutGenerator(&cut_mir, 1, "MIR");
-    model.setAllowableGap(1e-10);
-    CbcMain0(model);
-    model.branchAndBound(1);
-    ////////////////////
-    const double * var_solution = model.bestSolution();
-    if(var_solution == nullptr) {
+    std::unique_ptr<MIPBackend::Backend> backend = MIPBackend::create(
+        params.at("backend")->getInt(), backendParams(deadline));
+    backend->load(solver_builder, OSI_Builder::MAX);
+    if(!start_values.empty()) backend->setStart(start_values);
+    const bool has_cutoff = shared && incumbent_store->hasIncumbent();
+    if(has_cutoff) {
+        // the objective is ECA^2
+        const double cutoff_eca = incumbent_store->getBestValue();
+        backend->setCutoff(cutoff_eca * cutoff_eca);
+    }
+    if(shared) {
+        // the incumbents published during the search, called by the backend
+        // thread only
+        backend->setIncumbentPoll([&](std::vector<double> & values) {
+            if(incumbent_store->getBestValue() <= shared_eca) return false;
+            std::vector<double> coefs;
+            std::tie(shared_eca, coefs) = incumbent_store->getBest();
+            values = shared_start_values(coefs);
+            return true;
+        });
+    }
+    const bool found = backend->solve();
+    // nothing improves the cutoff : the shared incumbent is returned
+    if(!found && !has_cutoff) {
         std::cerr << name() << ": Fail" << std::endl;
-        delete solver;
         throw "caca";
     }
-    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
-        const int y_i = vars.y.id(i);
-        double value = var_solution[y_i];
-        solution.set(i, value);
+    if(log_level >= 1)
+        std::cout << name() << ": " << backend->name() << " stopped with bound "
+                  << backend->getBestBound() << " in " << chrono.lapTimeMs()
+                  << " ms" << (start_values.empty() ? " without" : " with")
+                  << " warm start" << std::endl;
+    if(found) {
+        const std::vector<double> & var_solution = backend->getSolution();
+        for(const RestorationPlan<MutableLandscape>::Option i :
+            plan.options())
+            solution.set(i, var_solution[vars.y.id(i)]);
+        solution.obj = backend->getObjValue();
+        solution.bound = backend->getBestBound();
+    } else {
+        const auto [eca, coefs] = incumbent_store->getBest();
+        for(const RestorationPlan<MutableLandscape>::Option i :
+            plan.options())
+            solution.set(i, coefs[i]);
+        solution.obj = eca * eca;
+        solution.bound = backend->isProvenOptimal()
+                             ? solution.obj
+                             : std::max(solution.obj, backend->getBestBound());
     }
-    solution.setComputeTimeMs(chrono.timeMs());
-    solution.obj = model.getObjValue();
+    solution.setComputeTimeMs(preprocessing_time + chrono.timeMs());
+    // the backend only stops early on its time limit
+    solution.status =
+        backend->isProvenOptimal() ? Solution::OPTIMAL : Solution::TIMEOUT;
     solution.nb_vars = solver_builder.getNbNonZeroVars();
     solution.nb_constraints = solver_builder.getNbConstraints();
-    solution.nb_elems = model.getNumElements();
+    solution.nb_elems = solver_builder.getNbElems();
     if(log_level >= 1) {
         std::cout << name()
                   << ": Complete solving : " << solution.getComputeTimeMs()
@@ -395,119 +505,313 @@ Solution Solvers::PL_ECA_3::solve(
         std::cout << name() << ": ECA from obj : " << std::sqrt(solution.obj)
                   << std::endl;
     }
-    delete solver;
     return solution;
-#else
-    const int nb_vars = solver_builder.getNbVars();
-    double * objective = solver_builder.getObjective();
-    double * col_lb = solver_builder.getColLB();
-    double * col_ub = solver_builder.getColUB();
-    char * vtype = new char[nb_vars];
-    for(OSI_Builder::VarType * varType : solver_builder.getVarTypes()) {
-        const int offset = varType->getOffset();
-        const int last_id = varType->getOffset() + varType->getNumber() - 1;
-        for(int i = offset; i <= last_id; i++) {
-            vtype[i] = (!relaxed && varType->isInteger() ? GRB_BINARY
-                                                         : GRB_CONTINUOUS);
-        }
-    }
-
-    CoinPackedMatrix * matrix = solver_builder.getMatrix();
-    const int nb_rows = matrix->getNumRows();
-    const int nb_elems = matrix->getNumElements();
-    int * begins = new int[nb_rows];
-    std::copy(matrix->getVectorStarts(), matrix->getVectorStarts() + nb_rows,
-              begins);
-    int * indices = new int[nb_elems];
-    std::copy(matrix->getIndices(), matrix->getIndices() + nb_elems, indices);
-    double * elements = new double[nb_elems];
-    std::copy(matrix->getElements(), matrix->getElements() + nb_elems,
-              elements);
-    double * row_lb = solver_builder.getRowLB();
-    double * row_ub = solver_builder.getRowUB();
-
-    GRBenv * env = NULL;
-    GRBmodel * model = NULL;
-    GRBemptyenv(&env);
-    GRBstartenv(env);
-    ////////////////////
-    GRBsetdblparam(env, GRB_DBL_PAR_MIPGAP, 1e-8);
-    GRBsetintparam(env, GRB_INT_PAR_LOGTOCONSOLE, (log_level >= 2 ? 1 : 0));
-    GRBsetintparam(env, GRB_INT_PAR_THREADS, 8);
-    GRBsetdblparam(env, GRB_DBL_PAR_TIMELIMIT, timeout);
-    ////////////////////
-    GRBnewmodel(env, &model, "pl_eca_3", 0, NULL, NULL, NULL, NULL, NULL);
-    GRBaddvars(model, nb_vars, 0, NULL, NULL, NULL, objective, col_lb, col_ub,
-               vtype, NULL);
-    GRBaddrangeconstrs(model, nb_rows, nb_elems, begins, indices, elements,
-                       row_lb, row_ub, NULL);
-    ////////////////////
-    GRBsetintattr(model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
+}
 
-    if(log_level >= 1) {
-        if(log_level >= 2) {
-            name_variables(solver_builder, landscape, plan, preprocessed_datas,
-                           vars);
-            OsiClpSolverInterface * solver_clp =
-                solver_builder.buildSolver<OsiClpSolverInterface>(
-                    OSI_Builder::MAX);
-            solver_clp->writeLp("pl_eca_3");
-            delete solver_clp;
-            std::cout << name() << ": LP printed to 'pl_eca_3.lp'" << std::endl;
-        }
+std::vector<Solution> Solvers::PL_ECA_3::solveBudgetSweep(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const std::vector<double> & budgets) const {
+    std::vector<Solution> solutions(budgets.size(), Solution(landscape, plan));
+    if(budgets.empty()) return solutions;
+    const int log_level = params.at("log")->getInt();
+    const int warm_start = params.at("warm_start")->getInt();
+    Chrono chrono;
+    if(log_level > 0)
+        std::cout << name() << ": Start preprocessing" << std::endl;
+    PreprocessedDatas preprocessed_datas(
+        landscape, plan,
+        M_budget(*std::max_element(budgets.begin(), budgets.end())));
+    const int preprocessing_time = chrono.lapTimeMs();
+    OSI_Builder solver_builder = OSI_Builder();
+    Variables vars(landscape, plan, preprocessed_datas);
+    insert_variables(solver_builder, vars, preprocessed_datas);
+    const int budget_row = fill_solver(solver_builder, landscape, plan,
+                                       budgets.front(), vars,
+                                       preprocessed_datas);
+    // no option has a positive cost : the budget row has not been pushed
+    const bool has_budget_row = budget_row < solver_builder.getNbConstraints();
+    if(log_level >= 1)
         std::cout << name() << ": Complete filling solver : "
                   << solver_builder.getNbConstraints() << " constraints and "
                   << solver_builder.getNbElems() << " entries in "
                   << chrono.lapTimeMs() << " ms" << std::endl;
-        std::cout << name() << ": Start solving" << std::endl;
-    }
 
-    GRBoptimize(model);
-    ////////////////////
-    int status;
-    GRBgetintattr(model, GRB_INT_ATTR_STATUS, &status);
-    if(status == GRB_INF_OR_UNBD) {
-        std::cout << "Model is infeasible or unbounded" << std::endl;
-    } else if(status != GRB_OPTIMAL) {
-        std::cout << "Optimization was stopped early" << std::endl;
-    }
-    double obj;
-    GRBgetdblattr(model, GRB_DBL_ATTR_OBJVAL, &obj);
-    double * var_solution = new double[nb_vars];
-    GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, nb_vars, var_solution);
-    if(var_solution == nullptr) {
-        std::cerr << name() << ": Fail" << std::endl;
-        assert(false);
+    // increasing budgets : the previous incumbent is feasible for the next
+    std::vector<std::size_t> order(budgets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&budgets](auto i, auto j) {
+        return budgets[i] < budgets[j];
+    });
+    // the first budget starts from the heuristic, the next ones from the
+    // previous incumbent
+    std::vector<double> start_values;
+    if(warm_start != WarmStart::NONE)
+        start_values = compute_start_values(
+            solver_builder, plan,
+            WarmStart::compute(warm_start, landscape, plan,
+                               budgets[order.front()], log_level),
+            vars, preprocessed_datas);
+
+    auto fill_solution = [&](Solution & solution,
+                             const double * var_solution, double obj,
+                             int nb_elems) {
+        for(const RestorationPlan<MutableLandscape>::Option i :
+            plan.options())
+            solution.set(i, var_solution[vars.y.id(i)]);
+        solution.setComputeTimeMs(chrono.lapTimeMs());
+        solution.preprocessing_time = preprocessing_time;
+        solution.obj = obj;
+        solution.nb_vars = solver_builder.getNbNonZeroVars();
+        solution.nb_constraints = solver_builder.getNbConstraints();
+        solution.nb_elems = nb_elems;
+    };
+    // the timeout applies to each budget
+    std::unique_ptr<MIPBackend::Backend> backend = MIPBackend::create(
+        params.at("backend")->getInt(), backendParams(makeDeadline()));
+    backend->load(solver_builder, OSI_Builder::MAX);
+    std::vector<double> & incumbent = start_values;
+    for(std::size_t k : order) {
+        const double B = budgets[k];
+        if(log_level >= 1)
+            std::cout << name() << ": Start solving with B = " << B
+                      << std::endl;
+        if(has_budget_row) backend->setRowUpper(budget_row, B);
+        if(!incumbent.empty()) backend->setStart(incumbent);
+        if(!backend->solve()) {
+            std::cerr << name() << ": Fail" << std::endl;
+            throw "caca";
+        }
+        incumbent = backend->getSolution();
+        fill_solution(solutions[k], incumbent.data(), backend->getObjValue(),
+                      solver_builder.getNbElems());
+        solutions[k].bound = backend->getBestBound();
+        solutions[k].status = backend->isProvenOptimal() ? Solution::OPTIMAL
+                                                         : Solution::TIMEOUT;
+        if(log_level >= 1)
+            std::cout << name() << ": Complete solving with B = " << B
+                      << " : " << solutions[k].getComputeTimeMs() << " ms"
+                      << std::endl;
     }
-    for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
-        const int y_i = vars.y.id(i);
-        double value = var_solution[y_i];
-        solution.set(i, value);
+    return solutions;
+}
+
+/**
+ * @return the value of target t for the options of solution, i.e. its
+ * decored quality times the flow reaching it
+ */
+double target_value(const MutableLandscape & landscape,
+                    const RestorationPlan<MutableLandscape> & plan,
+                    MutableLandscape::Node t, const Solution & solution,
+                    const PreprocessedDatas & pdatas) {
+    const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+    double quality = landscape.getQuality(t);
+    for(const auto & e : plan[t])
+        quality += solution[e.option] * e.quality_gain;
+    return quality * max_probability_tree_flow(cr.landscape, cr.plan, solution,
+                                               cr.t,
+                                               [](auto, auto, double) {});
+}
+
+Solution Solvers::PL_ECA_3::solveLazy(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B) const {
+    Solution solution(landscape, plan);
+    const int log_level = params.at("log")->getInt();
+    const int nb_initial_targets = params.at("lazy")->getInt();
+    const Deadline deadline = makeDeadline();
+    Chrono chrono;
+    if(log_level > 0)
+        std::cout << name() << ": Start preprocessing" << std::endl;
+    PreprocessedDatas pdatas(landscape, plan, M_budget(B));
+    const std::vector<MutableLandscape::Node> & targets = pdatas.target_nodes;
+    const int nb_targets = targets.size();
+    // surrogates of the value of each target
+    Solution empty_solution(landscape, plan);
+    std::vector<std::vector<RestorationPlan<MutableLandscape>::Option>>
+        target_options(nb_targets);
+    std::vector<double> value_0(nb_targets), value_all(nb_targets);
+    std::vector<int> target_indices(nb_targets);
+    std::iota(target_indices.begin(), target_indices.end(), 0);
+    std::for_each(
+        std::execution::par, target_indices.begin(), target_indices.end(),
+        [&](int k) {
+            const MutableLandscape::Node t = targets[k];
+            const ContractionResult & cr = *(*pdatas.contracted_instances)[t];
+            double max_quality = landscape.getQuality(t);
+            for(const auto & e : plan[t]) max_quality += e.quality_gain;
+            target_options[k] = relevant_options(plan, t, pdatas);
+            value_0[k] =
+                target_value(landscape, plan, t, empty_solution, pdatas);
+            value_all[k] = max_quality * (*pdatas.M_Maps_Map[t])[cr.t];
+        });
+    // the targets of highest value bound are active at start
+    std::vector<bool> active(nb_targets, false);
+    std::vector<int> ranked_indices = target_indices;
+    std::sort(ranked_indices.begin(), ranked_indices.end(),
+              [&](int k1, int k2) { return value_all[k1] > value_all[k2]; });
+    for(int l = 0; l < std::min(nb_initial_targets, nb_targets); ++l)
+        active[ranked_indices[l]] = true;
+    // a target with no option has its constant value
+    for(int k = 0; k < nb_targets; ++k)
+        if(target_options[k].empty()) active[k] = false;
+    solution.preprocessing_time = chrono.lapTimeMs();
+    if(log_level > 0)
+        std::cout << name()
+                  << ": Complete preprocessing : " << solution.preprocessing_time
+                  << " ms" << std::endl;
+
+    Solution current_solution(landscape, plan);
+    bool has_current_solution = false;
+    double obj = 0.0;
+    bool optimal = false;
+    int nb_vars = 0;
+    for(int iteration = 0;; ++iteration) {
+        OSI_Builder solver_builder;
+        YVar y(plan);
+        std::vector<std::unique_ptr<ContractedVars>> cvars(nb_targets);
+        std::vector<std::unique_ptr<FVar>> theta(nb_targets);
+        for(int k = 0; k < nb_targets; ++k) {
+            if(active[k]) {
+                cvars[k] = std::make_unique<ContractedVars>(
+                    *(*pdatas.contracted_instances)[targets[k]]);
+                solver_builder.addVarType(&cvars[k]->x)
+                    .addVarType(&cvars[k]->restored_x)
+                    .addVarType(&cvars[k]->f)
+                    .addVarType(&cvars[k]->restored_f);
+            } else {
+                theta[k] = std::make_unique<FVar>();
+                solver_builder.addVarType(theta[k].get());
+            }
+        }
+        solver_builder.addVarType(&y);
+        solver_builder.init();
+        int nb_active = 0;
+        for(int k = 0; k < nb_targets; ++k) {
+            if(active[k]) {
+                fill_target(solver_builder, landscape, plan, targets[k],
+                            *cvars[k], y, pdatas);
+                ++nb_active;
+                continue;
+            }
+            // theta_t <= v_t(0) + sum_i y_i * (v_t(all) - v_t(0))
+            const int theta_t = theta[k]->id();
+            solver_builder.setObjective(theta_t, 1);
+            solver_builder.setBounds(theta_t, 0, value_all[k]);
+            solver_builder.buffEntry(theta_t, 1);
+            for(const RestorationPlan<MutableLandscape>::Option i :
+                target_options[k])
+                solver_builder.buffEntry(y.id(i), value_0[k] - value_all[k]);
+            solver_builder.pushRow(-OSI_Builder::INFTY, value_0[k]);
+        }
+        for(const RestorationPlan<MutableLandscape>::Option i :
+            plan.options()) {
+            solver_builder.buffEntry(y.id(i), plan.getCost(i));
+            solver_builder.setInteger(y.id(i));
+        }
+        solver_builder.pushRow(-OSI_Builder::INFTY, B);
+        if(log_level >= 1)
+            std::cout << name() << ": iteration " << iteration << " : "
+                      << nb_active << " active targets, "
+                      << solver_builder.getNbVars() << " variables, "
+                      << solver_builder.getNbConstraints()
+                      << " constraints and " << solver_builder.getNbElems()
+                      << " entries" << std::endl;
+
+        MIPBackend::Params backend_params = backendParams(deadline);
+        // the surrogates need integer y values to be evaluated
+        backend_params.relaxed = false;
+        std::unique_ptr<MIPBackend::Backend> backend = MIPBackend::create(
+            params.at("backend")->getInt(), backend_params);
+        backend->load(solver_builder, OSI_Builder::MAX);
+        // the previous solution with its exact values is still feasible
+        if(has_current_solution) {
+            std::vector<double> start_values(solver_builder.getNbVars(), 0.0);
+            for(int k = 0; k < nb_targets; ++k) {
+                if(active[k])
+                    fill_target_start_values(start_values, plan, targets[k],
+                                             *cvars[k], current_solution,
+                                             pdatas);
+                else
+                    start_values[theta[k]->id()] = target_value(
+                        landscape, plan, targets[k], current_solution, pdatas);
+            }
+            for(const RestorationPlan<MutableLandscape>::Option i :
+                plan.options())
+                start_values[y.id(i)] = current_solution[i];
+            backend->setStart(start_values);
+        }
+        if(!backend->solve()) {
+            std::cerr << name() << ": Fail" << std::endl;
+            throw "caca";
+        }
+        const std::vector<double> & var_solution = backend->getSolution();
+        for(const RestorationPlan<MutableLandscape>::Option i :
+            plan.options())
+            current_solution.set(i, std::round(var_solution[y.id(i)]));
+        has_current_solution = true;
+        obj = backend->getObjValue();
+        solution.bound = backend->getBestBound();
+        optimal = backend->isProvenOptimal();
+        nb_vars = solver_builder.getNbVars();
+        solution.nb_vars = solver_builder.getNbNonZeroVars();
+        solution.nb_constraints = solver_builder.getNbConstraints();
+        solution.nb_elems = solver_builder.getNbElems();
+        // activates the targets whose surrogate is violated
+        std::vector<double> values(nb_targets);
+        std::for_each(std::execution::par, target_indices.begin(),
+                      target_indices.end(), [&](int k) {
+                          if(active[k]) return;
+                          values[k] = target_value(landscape, plan, targets[k],
+                                                   current_solution, pdatas);
+                      });
+        int nb_violated = 0;
+        for(int k = 0; k < nb_targets; ++k) {
+            if(active[k]) continue;
+            if(var_solution[theta[k]->id()] <=
+               values[k] + 1e-6 * std::max(1.0, values[k]))
+                continue;
+            active[k] = true;
+            ++nb_violated;
+        }
+        if(log_level >= 1)
+            std::cout << name() << ": iteration " << iteration << " : obj "
+                      << obj << ", " << nb_violated << " violated surrogates, "
+                      << chrono.lapTimeMs() << " ms" << std::endl;
+        if(nb_violated == 0) break;
+        if(deadline.expired()) {
+            optimal = false;
+            break;
+        }
     }
+    ////////////////////
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        solution.set(i, current_solution[i]);
     solution.setComputeTimeMs(chrono.timeMs());
-    solution.obj = obj;
-    solution.nb_vars = solver_builder.getNbNonZeroVars();
-    solution.nb_constraints = solver_builder.getNbConstraints();
-    solution.nb_elems = nb_elems;
+    // obj is the surrogate model value, that overestimates current_solution
+    // while surrogates are violated : only the bound comes from the model
+    solution.obj = std::pow(
+        ECA().eval(Helper::decore_landscape(landscape, plan, current_solution)),
+        2);
+    // the surrogates overestimate the targets values : the bound holds
+    solution.status = optimal ? Solution::OPTIMAL : Solution::TIMEOUT;
     if(log_level >= 1) {
+        int nb_monolithic_vars = plan.getNbOptions();
+        for(MutableLandscape::Node t : targets) {
+            const ContractedVars cvars(*(*pdatas.contracted_instances)[t]);
+            nb_monolithic_vars +=
+                cvars.x.getNumber() + cvars.restored_x.getNumber() +
+                cvars.f.getNumber() + cvars.restored_f.getNumber();
+        }
         std::cout << name()
                   << ": Complete solving : " << solution.getComputeTimeMs()
-                  << " ms" << std::endl;
+                  << " ms with " << nb_vars << " variables ("
+                  << nb_monolithic_vars << " in the monolithic model)"
+                  << std::endl;
         std::cout << name() << ": ECA from obj : " << std::sqrt(solution.obj)
                   << std::endl;
     }
-
-    GRBfreemodel(model);
-    GRBfreeenv(env);
-
-    delete[] vtype;
-    delete[] begins;
-    delete[] indices;
-    delete[] elements;
-    delete[] var_solution;
-
     return solution;
-#endif
 }
 
 double Solvers::PL_ECA_3::eval(const MutableLandscape & landscape,
@@ -515,8 +819,24 @@ double Solvers::PL_ECA_3::eval(const MutableLandscape & landscape,
                                const double B,
                                const Solution & solution) const {
     const int log_level = params.at("log")->getInt();
+    const std::vector<double> & coefs = solution.getCoefs();
+    const bool integral = std::all_of(coefs.begin(), coefs.end(),
+                                      [](double c) { return c == 0 || c == 1; });
+    if(!integral) return evalLP(landscape, plan, B, solution);
+    const double obj = std::pow(
+        Parallel_ECA().eval(Helper::decore_landscape(landscape, plan, solution)),
+        2);
+    if(log_level >= 1) std::cout << name() << ": eval : " << obj << std::endl;
+    return obj;
+}
+
+double Solvers::PL_ECA_3::evalLP(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B,
+    const Solution & solution) const {
+    const int log_level = params.at("log")->getInt();
     Chrono chrono;
-    PreprocessedDatas preprocessed_datas(landscape, plan);
+    PreprocessedDatas preprocessed_datas(landscape, plan, M_budget(B));
     OSI_Builder solver_builder = OSI_Builder();
     Variables vars(landscape, plan, preprocessed_datas);
     insert_variables(solver_builder, vars, preprocessed_datas);
@@ -0,0 +1,106 @@
+#include "solvers/portfolio.hpp"
+
+Solution Solvers::Portfolio::solve(
+    const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B) const {
+    Solution solution(landscape, plan);
+    const int log_level = params.at("log")->getInt();
+    const int nb_threads = params.at("threads")->getInt();
+    const int timeout = params.at("timeout")->getInt();
+    const Deadline deadline = makeDeadline();
+    Chrono chrono;
+    if(solvers.empty()) return solution;
+
+    // one thread for each sequential solver, the remaining for the others
+    const int nb_solvers = solvers.size();
+    const int nb_multithreaded = std::count_if(
+        solvers.begin(), solvers.end(), [](const auto & solver) {
+            return solver->getParams().count("threads") > 0;
+        });
+    const int nb_shared_threads =
+        nb_multithreaded > 0
+            ? std::max(1, (nb_threads - (nb_solvers - nb_multithreaded)) /
+                              nb_multithreaded)
+            : 1;
+    IncumbentStore store;
+    // the overriden parameters, restored once the race is over
+    const std::vector<std::string> overriden_params = {"timeout", "threads",
+                                                       "parallel"};
+    std::vector<std::map<std::string, double>> saved_params(nb_solvers);
+    for(int k = 0; k < nb_solvers; ++k)
+        for(const std::string & param_name : overriden_params)
+            if(solvers[k]->getParams().count(param_name) > 0)
+                saved_params[k][param_name] =
+                    solvers[k]->getParams().at(param_name)->getDouble();
+    for(const auto & solver : solvers) {
+        solver->setIncumbentStore(&store);
+        if(timeout > 0)
+            solver->setParam("timeout", std::to_string(timeout).c_str());
+        solver->setParam("threads",
+                         std::to_string(nb_shared_threads).c_str());
+        solver->setParam("parallel", nb_solvers > 1 ? "0" : "1");
+    }
+    if(log_level >= 1)
+        std::cout << name() << ": Start " << nb_solvers << " solvers, "
+                  << nb_shared_threads << " threads for the multithreaded ones"
+                  << std::endl;
+
+    std::vector<double> bounds(nb_solvers,
+                               std::numeric_limits<double>::infinity());
+    std::vector<std::thread> threads;
+    for(int k = 0; k < nb_solvers; ++k) {
+        threads.emplace_back([&, k]() {
+            const concepts::Solver & solver = *solvers[k];
+            try {
+                const Solution member_solution =
+                    solver.solve(landscape, plan, B);
+                const double eca = ECA().eval(
+                    Helper::decore_landscape(landscape, plan, member_solution));
+                const bool improved = store.publish(member_solution, eca);
+                // the other solvers stop at their next deadline check
+                if(member_solution.status == Solution::OPTIMAL) store.close();
+                bounds[k] = member_solution.bound;
+                if(log_level >= 1)
+                    std::cout << name() << ": " << solver.name()
+                              << " returned ECA " << eca << " in "
+                              << chrono.timeMs() << " ms"
+                              << (improved ? ", new incumbent" : "")
+                              << std::endl;
+            } catch(...) {
+                std::cerr << name() << ": " << solver.name() << " Fail"
+                          << std::endl;
+            }
+        });
+    }
+    for(std::thread & thread : threads) thread.join();
+    for(int k = 0; k < nb_solvers; ++k) {
+        solvers[k]->setIncumbentStore(nullptr);
+        for(const auto & [param_name, value] : saved_params[k])
+            solvers[k]->getParams().at(param_name)->set(value);
+    }
+
+    if(!store.hasIncumbent()) {
+        std::cerr << name() << ": Fail" << std::endl;
+        throw "caca";
+    }
+    const std::vector<double> coefs = store.getBestCoefs();
+    for(const RestorationPlan<MutableLandscape>::Option i : plan.options())
+        solution.set(i, coefs[i]);
+    solution.setComputeTimeMs(chrono.timeMs());
+    solution.obj = store.getBestValue();
+    // the solvers proving a bound optimize ECA^2
+    const double bound = *std::min_element(bounds.begin(), bounds.end());
+    solution.bound = std::sqrt(bound);
+    if(store.isClosed())
+        solution.status = Solution::OPTIMAL;
+    else if(deadline.expired())
+        solution.status = Solution::TIMEOUT;
+    if(log_level >= 1) {
+        std::cout << name()
+                  << ": Complete solving : " << solution.getComputeTimeMs()
+                  << " ms" << std::endl;
+        std::cout << name() << ": ECA : " << solution.obj << " , bound : "
+                  << solution.bound << std::endl;
+    }
+    return solution;
+}
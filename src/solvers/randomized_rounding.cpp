@@ -3,10 +3,9 @@
 static Solution job(const MutableLandscape & landscape,
                     const RestorationPlan<MutableLandscape> & plan,
                     const double B, const Solution & relaxed_solution,
-                    int nb_draws) {
+                    int nb_draws, const Deadline & deadline) {
     Solution best_solution(landscape, plan);
-    const auto nodeOptions = plan.computeNodeOptionsMap();
-    const auto arcOptions = plan.computeArcOptionsMap();
+    const auto compiled_plan = plan.compile();
 
     RandomChooser<RestorationPlan<MutableLandscape>::Option> option_chooser;
     for(const RestorationPlan<MutableLandscape>::Option i : plan.options()) {
@@ -21,19 +20,24 @@ static Solution job(const MutableLandscape & landscape,
     double best_eca = 0.0;
 
     for(int i = 0; i < nb_draws; i++) {
+        if(deadline.expired()) {
+            best_solution.status = Solution::TIMEOUT;
+            break;
+        }
         option_chooser.reset();
+        Helper::undecore_landscape(decored_landscape, compiled_plan,
+                                   purschaised_options);
         purschaised_options.clear();
         purschaised = 0.0;
-        decored_landscape.reset();
         while(option_chooser.canPick()) {
             RestorationPlan<MutableLandscape>::Option option =
                 option_chooser.pick();
             if(purschaised + plan.getCost(option) > B) continue;
             purschaised_options.push_back(option);
             purschaised += plan.getCost(option);
-
-            decored_landscape.apply(nodeOptions[option], arcOptions[option]);
         }
+        Helper::decore_landscape(decored_landscape, compiled_plan,
+                                 purschaised_options);
         double eca = ECA().eval(decored_landscape);
 
         if(eca > best_eca) {
@@ -60,10 +64,14 @@ Solution Solvers::Randomized_Rounding_ECA::solve(
     const int log_level = params.at("log")->getInt();
     const int nb_draws = params.at("draws")->getInt();
     const bool parallel = params.at("parallel")->getBool();
+    const Deadline deadline = makeDeadline();
     Chrono chrono;
 
     Solvers::PL_ECA_3 pl_eca_3;
     pl_eca_3.setLogLevel(log_level).setRelaxed(1);
+    if(!deadline.isUnlimited())
+        pl_eca_3.setTimeout(
+            std::max(1, static_cast<int>(std::ceil(deadline.remainingS()))));
 
     Solution relaxed_solution = pl_eca_3.solve(landscape, plan, B);
 
@@ -83,14 +91,15 @@ Solution Solvers::Randomized_Rounding_ECA::solve(
         std::vector<Solution> v(nb_threads, Solution(landscape, plan));
         std::generate(std::execution::par, v.begin(), v.end(), [&]() {
             return job(landscape, plan, B, relaxed_solution,
-                       nb_draws_per_thread);
+                       nb_draws_per_thread, deadline);
         });
         solution = *std::max_element(v.begin(), v.end(),
                                      [](const Solution s1, const Solution s2) {
                                          return s1.obj > s2.obj;
                                      });
     } else {
-        solution = job(landscape, plan, B, relaxed_solution, nb_draws);
+        solution =
+            job(landscape, plan, B, relaxed_solution, nb_draws, deadline);
     }
 
     solution.setComputeTimeMs(chrono.timeMs());
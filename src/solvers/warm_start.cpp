@@ -0,0 +1,24 @@
+#include "solvers/warm_start.hpp"
+
+#include "solvers/glutton_eca_inc.hpp"
+#include "solvers/naive_eca_inc.hpp"
+
+Solution Solvers::WarmStart::compute(
+    int heuristic, const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan, const double B,
+    const int log_level) {
+    switch(heuristic) {
+        case GLUTTON_ECA_INC: {
+            Solvers::Glutton_ECA_Inc glutton;
+            glutton.setParallel(true).setLogLevel(log_level > 1 ? 1 : 0);
+            return glutton.solve(landscape, plan, B);
+        }
+        case NAIVE_ECA_INC: {
+            Solvers::Naive_ECA_Inc naive;
+            naive.setParallel(true).setLogLevel(log_level > 1 ? 1 : 0);
+            return naive.solve(landscape, plan, B);
+        }
+        default:
+            return Solution(landscape, plan);
+    }
+}
@@ -0,0 +1,195 @@
+#ifdef WITH_GUROBI
+#include "utils/mip_backend.hpp"
+
+#include <cmath>
+#include <iostream>
+
+#include "gurobi_c.h"
+
+namespace MIPBackend {
+/**
+ * @brief Injects the solutions of the IncumbentPoll given as usrdata at each
+ * node of the search.
+ */
+static int __stdcall incumbent_poll_callback(GRBmodel * model,
+                                             void * cbdata, int where,
+                                             void * usrdata) {
+    if(where != GRB_CB_MIPNODE) return 0;
+    const IncumbentPoll & incumbent_poll =
+        *static_cast<const IncumbentPoll *>(usrdata);
+    std::vector<double> values;
+    if(!incumbent_poll(values)) return 0;
+    double obj;
+    return GRBcbsolution(cbdata, values.data(), &obj);
+}
+
+class GurobiBackend : public Backend {
+private:
+    GRBenv * _env;
+    GRBmodel * _model;
+    int _nb_vars;
+    // the range rows are stored by gurobi as expr - s = lb, 0 <= s <= ub - lb
+    std::vector<bool> _ranged_rows;
+    std::vector<double> _solution;
+
+    bool isInfinite(double value) const { return std::abs(value) >= 1e30; }
+
+public:
+    GurobiBackend(const Params & params)
+        : Backend(params), _env(nullptr), _model(nullptr), _nb_vars(0) {
+        GRBemptyenv(&_env);
+        GRBstartenv(_env);
+        GRBsetintparam(_env, GRB_INT_PAR_LOGTOCONSOLE,
+                       (_params.log_level >= 2 ? 1 : 0));
+        GRBsetintparam(_env, GRB_INT_PAR_THREADS, _params.nb_threads);
+        GRBsetdblparam(_env, GRB_DBL_PAR_MIPGAP, _params.gap);
+        if(_params.time_limit > 0)
+            GRBsetdblparam(_env, GRB_DBL_PAR_TIMELIMIT, _params.time_limit);
+    }
+    ~GurobiBackend() {
+        GRBfreemodel(_model);
+        GRBfreeenv(_env);
+    }
+
+    const std::string name() const { return "gurobi"; }
+
+    void load(OSI_Builder & solver_builder, int sense) {
+        _nb_vars = solver_builder.getNbVars();
+        std::vector<char> vtype(_nb_vars, GRB_CONTINUOUS);
+        if(!_params.relaxed) {
+            double * col_lb = solver_builder.getColLB();
+            double * col_ub = solver_builder.getColUB();
+            for(int var_id : solver_builder.getIntegers())
+                vtype[var_id] = (col_lb[var_id] >= 0 && col_ub[var_id] <= 1)
+                                    ? GRB_BINARY
+                                    : GRB_INTEGER;
+        }
+        GRBnewmodel(_env, &_model, "landscape_opt", 0, NULL, NULL, NULL, NULL,
+                    NULL);
+        GRBaddvars(_model, _nb_vars, 0, NULL, NULL, NULL,
+                   solver_builder.getObjective(), solver_builder.getColLB(),
+                   solver_builder.getColUB(), vtype.data(), NULL);
+        ////////////////////
+        const CoinPackedMatrix * matrix = solver_builder.getMatrix();
+        const int nb_rows = matrix->getNumRows();
+        const CoinBigIndex * starts = matrix->getVectorStarts();
+        const int * lengths = matrix->getVectorLengths();
+        std::vector<int> indices(matrix->getIndices(),
+                                 matrix->getIndices() +
+                                     matrix->getNumElements());
+        std::vector<double> elements(matrix->getElements(),
+                                     matrix->getElements() +
+                                         matrix->getNumElements());
+        const double * row_lb = solver_builder.getRowLB();
+        const double * row_ub = solver_builder.getRowUB();
+        _ranged_rows.assign(nb_rows, false);
+        // the one sided rows are added as plain constraints for their rhs to
+        // be modifiable, the range constraints come with a slack variable
+        // the matrix has no gaps : the rows of a batch are contiguous
+        std::vector<int> begins;
+        std::vector<char> senses;
+        std::vector<double> rhs;
+        CoinBigIndex batch_start = 0;
+        int nb_entries = 0;
+        auto flush = [&]() {
+            if(begins.empty()) return;
+            GRBaddconstrs(_model, begins.size(), nb_entries, begins.data(),
+                          indices.data() + batch_start,
+                          elements.data() + batch_start, senses.data(),
+                          rhs.data(), NULL);
+            begins.clear();
+            senses.clear();
+            rhs.clear();
+            nb_entries = 0;
+        };
+        for(int row_id = 0; row_id < nb_rows; ++row_id) {
+            const double lb = row_lb[row_id];
+            const double ub = row_ub[row_id];
+            const bool ranged =
+                lb != ub && !isInfinite(lb) && !isInfinite(ub);
+            if(ranged) {
+                _ranged_rows[row_id] = true;
+                flush();
+                GRBaddrangeconstr(_model, lengths[row_id],
+                                  indices.data() + starts[row_id],
+                                  elements.data() + starts[row_id], lb, ub,
+                                  NULL);
+                continue;
+            }
+            if(begins.empty()) batch_start = starts[row_id];
+            begins.push_back(starts[row_id] - batch_start);
+            if(lb == ub) {
+                senses.push_back(GRB_EQUAL);
+                rhs.push_back(ub);
+            } else if(isInfinite(ub)) {
+                senses.push_back(GRB_GREATER_EQUAL);
+                rhs.push_back(lb);
+            } else {
+                senses.push_back(GRB_LESS_EQUAL);
+                rhs.push_back(ub);
+            }
+            nb_entries += lengths[row_id];
+        }
+        flush();
+        GRBsetintattr(_model, GRB_INT_ATTR_MODELSENSE,
+                      sense == OSI_Builder::MAX ? GRB_MAXIMIZE : GRB_MINIMIZE);
+    }
+    void setRowUpper(int row_id, double ub) {
+        // the RHS of a range row is its lower bound
+        if(_ranged_rows[row_id]) {
+            std::cerr << name() << ": setRowUpper on the range row " << row_id
+                      << std::endl;
+            throw "caca";
+        }
+        GRBsetdblattrelement(_model, GRB_DBL_ATTR_RHS, row_id, ub);
+    }
+    void setStart(const std::vector<double> & values) {
+        GRBsetdblattrarray(_model, GRB_DBL_ATTR_START, 0, _nb_vars,
+                           const_cast<double *>(values.data()));
+    }
+
+    bool solve() {
+        _solution.clear();
+        // the model has its own copy of the environment
+        if(_has_cutoff)
+            GRBsetdblparam(GRBgetenv(_model), GRB_DBL_PAR_CUTOFF, _cutoff);
+        if(_incumbent_poll)
+            GRBsetcallbackfunc(_model, incumbent_poll_callback,
+                               &_incumbent_poll);
+        else
+            GRBsetcallbackfunc(_model, NULL, NULL);
+        GRBoptimize(_model);
+        int nb_solutions = 0;
+        GRBgetintattr(_model, GRB_INT_ATTR_SOLCOUNT, &nb_solutions);
+        if(nb_solutions == 0) return false;
+        _solution.resize(_nb_vars);
+        GRBgetdblattrarray(_model, GRB_DBL_ATTR_X, 0, _nb_vars,
+                           _solution.data());
+        return true;
+    }
+
+    bool isProvenOptimal() const {
+        int status;
+        GRBgetintattr(_model, GRB_INT_ATTR_STATUS, &status);
+        return status == GRB_OPTIMAL || status == GRB_CUTOFF;
+    }
+    double getObjValue() const {
+        double obj;
+        GRBgetdblattr(_model, GRB_DBL_ATTR_OBJVAL, &obj);
+        return obj;
+    }
+    double getBestBound() const {
+        // unavailable when no solution improves the cutoff
+        double bound = GRB_INFINITY;
+        if(_params.relaxed) return getObjValue();
+        GRBgetdblattr(_model, GRB_DBL_ATTR_OBJBOUND, &bound);
+        return bound;
+    }
+    const std::vector<double> & getSolution() const { return _solution; }
+};
+
+std::unique_ptr<Backend> createGurobi(const Params & params) {
+    return std::make_unique<GurobiBackend>(params);
+}
+}  // namespace MIPBackend
+#endif
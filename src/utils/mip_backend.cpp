@@ -0,0 +1,145 @@
+#include "utils/mip_backend.hpp"
+
+#include <iostream>
+#include <limits>
+
+#include "CbcEventHandler.hpp"
+#include "CglFlowCover.hpp"
+#include "CglMixedIntegerRounding2.hpp"
+
+namespace MIPBackend {
+#ifdef WITH_GUROBI
+std::unique_ptr<Backend> createGurobi(const Params & params);
+#endif
+
+/**
+ * @brief Injects the solutions of an IncumbentPoll at each node of the search.
+ */
+class IncumbentPollHandler : public CbcEventHandler {
+private:
+    IncumbentPoll _incumbent_poll;
+    std::vector<double> _values;
+
+public:
+    IncumbentPollHandler(IncumbentPoll incumbent_poll)
+        : CbcEventHandler(), _incumbent_poll(std::move(incumbent_poll)) {}
+    CbcEventHandler * clone() const { return new IncumbentPollHandler(*this); }
+
+    CbcAction event(CbcEvent which_event) {
+        if(which_event != node || !_incumbent_poll(_values)) return noAction;
+        // cbc minimizes internally, the value is checked and recomputed
+        const double * objective = model_->getObjCoefficients();
+        double obj = 0.0;
+        for(std::size_t var_id = 0; var_id < _values.size(); ++var_id)
+            obj += objective[var_id] * _values[var_id];
+        obj *= model_->getObjSense();
+        model_->setBestSolution(CBC_ROUNDING, obj, _values.data());
+        return noAction;
+    }
+};
+
+class CbcBackend : public Backend {
+private:
+    std::unique_ptr<OsiSolverInterface> _solver;
+    std::vector<double> _start;
+    std::vector<double> _solution;
+    double _obj;
+    double _bound;
+    bool _optimal;
+
+public:
+    CbcBackend(const Params & params)
+        : Backend(params)
+        , _obj(0)
+        , _bound(std::numeric_limits<double>::infinity())
+        , _optimal(false) {}
+
+    const std::string name() const { return "cbc"; }
+
+    void load(OSI_Builder & solver_builder, int sense) {
+        _solver.reset(solver_builder.buildSolver<OsiClpSolverInterface>(
+            sense, _params.relaxed));
+        if(_params.log_level <= 1) _solver->setHintParam(OsiDoReducePrint);
+        if(_params.log_level <= 0) _solver->messageHandler()->setLogLevel(0);
+    }
+    void setRowUpper(int row_id, double ub) { _solver->setRowUpper(row_id, ub); }
+    void setStart(const std::vector<double> & values) { _start = values; }
+
+    bool solve() {
+        const int nb_vars = _solver->getNumCols();
+        _solution.clear();
+        _solver->initialSolve();
+        if(_params.relaxed) {
+            _optimal = _solver->isProvenOptimal();
+            if(!_optimal) return false;
+            _obj = _bound = _solver->getObjValue();
+            _solution.assign(_solver->getColSolution(),
+                             _solver->getColSolution() + nb_vars);
+            return true;
+        }
+        CbcModel model(*_solver);
+        model.setLogLevel(_params.log_level - 1);
+        model.setNumberThreads(_params.nb_threads);
+        if(_params.time_limit > 0) model.setMaximumSeconds(_params.time_limit);
+        model.setAllowableGap(1e-10);
+        model.setAllowableFractionGap(_params.gap);
+        CglFlowCover cut_flow;
+        model.addCutGenerator(&cut_flow, 1, "FlowCover");
+        CglMixedIntegerRounding2 cut_mir;
+        model.addCutGenerator(&cut_mir, 1, "MIR");
+        if(!_start.empty())
+            model.setBestSolution(_start.data(), nb_vars, COIN_DBL_MAX, true);
+        CbcMain0(model);
+        // the cbc cutoff is in the minimization sense
+        if(_has_cutoff) model.setCutoff(_solver->getObjSense() * _cutoff);
+        if(_incumbent_poll) {
+            IncumbentPollHandler handler(_incumbent_poll);
+            model.passInEventHandler(&handler);
+        }
+        model.branchAndBound(1);
+        // nothing improves the cutoff : the model looks infeasible
+        _optimal = model.isProvenOptimal() ||
+                   (_has_cutoff && model.isProvenInfeasible());
+        _bound = model.getBestPossibleObjValue();
+        const double * var_solution = model.bestSolution();
+        if(var_solution == nullptr) return false;
+        _obj = model.getObjValue();
+        _solution.assign(var_solution, var_solution + nb_vars);
+        return true;
+    }
+
+    bool isProvenOptimal() const { return _optimal; }
+    double getObjValue() const { return _obj; }
+    double getBestBound() const { return _bound; }
+    const std::vector<double> & getSolution() const { return _solution; }
+};
+
+bool isAvailable(int type) {
+    switch(type) {
+        case CBC:
+            return true;
+        case GUROBI:
+#ifdef WITH_GUROBI
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+int defaultType() { return isAvailable(GUROBI) ? GUROBI : CBC; }
+
+std::unique_ptr<Backend> create(int type, const Params & params) {
+    if(!isAvailable(type)) {
+        std::cerr << "MIPBackend: backend " << type
+                  << " not available, fallback to cbc" << std::endl;
+        type = CBC;
+    }
+#ifdef WITH_GUROBI
+    if(type == GUROBI) return createGurobi(params);
+#endif
+    return std::make_unique<CbcBackend>(params);
+}
+}  // namespace MIPBackend
@@ -1,5 +1,13 @@
 #include "utils/osi_builder.hpp"
 
+#include <algorithm>
+
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <fmt/format.h>
+
 OSI_Builder::OSI_Builder() : nb_vars{0}, nb_entries{0}, matrix(nullptr) {}
 OSI_Builder::~OSI_Builder() {
     delete[] objective;
@@ -90,4 +98,276 @@ OSI_Builder & OSI_Builder::setContinuous(int var_id) {
 OSI_Builder & OSI_Builder::setInteger(int var_id) {
     integers_variables.push_back(var_id);
     return *this;
-}
\ No newline at end of file
+}
+
+namespace {
+/**
+ * Output file written through a fmt buffer, gzip compressed if its name ends
+ * with ".gz".
+ */
+class ModelFile {
+private:
+    static constexpr std::size_t FLUSH_SIZE = 1 << 20;
+    boost::iostreams::filtering_ostream out;
+    fmt::memory_buffer buffer;
+
+public:
+    ModelFile(const std::string & file_name) {
+        const std::string gz = ".gz";
+        if(file_name.size() >= gz.size() &&
+           file_name.compare(file_name.size() - gz.size(), gz.size(), gz) == 0)
+            out.push(boost::iostreams::gzip_compressor());
+        out.push(boost::iostreams::file_sink(file_name, std::ios_base::binary));
+    }
+    ~ModelFile() {
+        flush();
+        out.reset();
+    }
+    template <typename... Args>
+    void write(fmt::format_string<Args...> format, Args &&... args) {
+        fmt::format_to(std::back_inserter(buffer), format,
+                       std::forward<Args>(args)...);
+        if(buffer.size() >= FLUSH_SIZE) flush();
+    }
+    void flush() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+};
+
+/**
+ * Column names generated on the fly from the VarTypes : the i-th column of a
+ * VarType named prefix is prefix + i, an unnamed VarType k is named v<k>_.
+ */
+class ColumnNames {
+private:
+    std::vector<int> offsets;
+    std::vector<std::string> prefixes;
+
+public:
+    ColumnNames(const std::vector<OSI_Builder::VarType *> & varTypes) {
+        for(OSI_Builder::VarType * varType : varTypes) {
+            if(varType->getNumber() == 0) continue;
+            offsets.push_back(varType->getOffset());
+            prefixes.push_back(varType->getName().empty()
+                                   ? fmt::format("v{}_", prefixes.size())
+                                   : varType->getName());
+        }
+    }
+    std::pair<const std::string &, int> operator[](int var_id) const {
+        const int k =
+            std::distance(offsets.begin(), std::upper_bound(offsets.begin(),
+                                                            offsets.end(),
+                                                            var_id)) -
+            1;
+        return {prefixes[k], var_id - offsets[k]};
+    }
+};
+
+bool is_infinite(double value) { return std::abs(value) >= 1e30; }
+}  // namespace
+
+void OSI_Builder::writeLp(const std::string & file_name, int sense,
+                          bool relaxed) const {
+    ModelFile file(file_name);
+    const ColumnNames names(varTypes);
+    const int nb_rows = matrix->getNumRows();
+    const CoinBigIndex * starts = matrix->getVectorStarts();
+    const int * lengths = matrix->getVectorLengths();
+    const int * indices = matrix->getIndices();
+    const double * elements = matrix->getElements();
+
+    auto write_term = [&](double coef, int var_id, int nb_terms) {
+        const auto [prefix, index] = names[var_id];
+        // keep the lines short
+        if(nb_terms > 0 && nb_terms % 8 == 0) file.write("\n");
+        file.write(" {} {} {}{}", coef < 0 ? '-' : '+', std::abs(coef),
+                   prefix, index);
+    };
+    auto write_row = [&](int row_id) {
+        for(CoinBigIndex k = starts[row_id];
+            k < starts[row_id] + lengths[row_id]; ++k)
+            write_term(elements[k], indices[k], k - starts[row_id]);
+    };
+
+    file.write("\\ {} columns, {} rows\n", nb_vars, nb_rows);
+    file.write("{}\n obj:", sense == MAX ? "Maximize" : "Minimize");
+    int nb_terms = 0;
+    for(int var_id = 0; var_id < nb_vars; ++var_id) {
+        if(objective[var_id] == 0) continue;
+        write_term(objective[var_id], var_id, nb_terms++);
+    }
+    file.write("\nSubject To\n");
+    for(int row_id = 0; row_id < nb_rows; ++row_id) {
+        const double lb = row_lb[row_id];
+        const double ub = row_ub[row_id];
+        if(is_infinite(lb) && is_infinite(ub)) continue;
+        if(lb == ub) {
+            file.write(" r{}:", row_id);
+            write_row(row_id);
+            file.write(" = {}\n", ub);
+            continue;
+        }
+        // ranged rows are split in two
+        if(!is_infinite(lb)) {
+            file.write(is_infinite(ub) ? " r{}:" : " r{}_lb:", row_id);
+            write_row(row_id);
+            file.write(" >= {}\n", lb);
+        }
+        if(!is_infinite(ub)) {
+            file.write(is_infinite(lb) ? " r{}:" : " r{}_ub:", row_id);
+            write_row(row_id);
+            file.write(" <= {}\n", ub);
+        }
+    }
+    file.write("Bounds\n");
+    for(int var_id = 0; var_id < nb_vars; ++var_id) {
+        const double lb = col_lb[var_id];
+        const double ub = col_ub[var_id];
+        const auto [prefix, index] = names[var_id];
+        if(lb == 0 && is_infinite(ub)) continue;
+        if(is_infinite(lb) && is_infinite(ub))
+            file.write(" {}{} free\n", prefix, index);
+        else if(lb == ub)
+            file.write(" {}{} = {}\n", prefix, index, lb);
+        else if(is_infinite(lb))
+            file.write(" -inf <= {}{} <= {}\n", prefix, index, ub);
+        else if(is_infinite(ub))
+            file.write(" {}{} >= {}\n", prefix, index, lb);
+        else
+            file.write(" {} <= {}{} <= {}\n", lb, prefix, index, ub);
+    }
+    const std::vector<int> integers = getIntegers();
+    if(!relaxed && !integers.empty()) {
+        file.write("Generals\n");
+        for(int var_id : integers) {
+            const auto [prefix, index] = names[var_id];
+            file.write(" {}{}\n", prefix, index);
+        }
+    }
+    file.write("End\n");
+}
+
+void OSI_Builder::writeMps(const std::string & file_name, int sense,
+                           bool relaxed) const {
+    ModelFile file(file_name);
+    const ColumnNames names(varTypes);
+    const int nb_rows = matrix->getNumRows();
+    const CoinBigIndex * starts = matrix->getVectorStarts();
+    const int * lengths = matrix->getVectorLengths();
+    const int * indices = matrix->getIndices();
+    const double * elements = matrix->getElements();
+    ////////////////////
+    // rows
+    std::vector<char> row_types(nb_rows);
+    for(int row_id = 0; row_id < nb_rows; ++row_id) {
+        const double lb = row_lb[row_id];
+        const double ub = row_ub[row_id];
+        if(is_infinite(lb) && is_infinite(ub))
+            row_types[row_id] = 'N';
+        else if(lb == ub)
+            row_types[row_id] = 'E';
+        else if(is_infinite(ub))
+            row_types[row_id] = 'G';
+        else
+            row_types[row_id] = 'L';
+    }
+    ////////////////////
+    // the matrix is row-major : counting sort of the entries by column
+    std::vector<CoinBigIndex> col_starts(nb_vars + 1, 0);
+    for(int row_id = 0; row_id < nb_rows; ++row_id)
+        for(CoinBigIndex k = starts[row_id];
+            k < starts[row_id] + lengths[row_id]; ++k)
+            ++col_starts[indices[k] + 1];
+    std::partial_sum(col_starts.begin(), col_starts.end(), col_starts.begin());
+    std::vector<int> col_rows(col_starts.back());
+    std::vector<double> col_elements(col_starts.back());
+    {
+        std::vector<CoinBigIndex> positions(col_starts.begin(),
+                                            col_starts.end() - 1);
+        for(int row_id = 0; row_id < nb_rows; ++row_id)
+            for(CoinBigIndex k = starts[row_id];
+                k < starts[row_id] + lengths[row_id]; ++k) {
+                const CoinBigIndex position = positions[indices[k]]++;
+                col_rows[position] = row_id;
+                col_elements[position] = elements[k];
+            }
+    }
+    std::vector<bool> is_integer(nb_vars, false);
+    if(!relaxed)
+        for(int var_id : getIntegers()) is_integer[var_id] = true;
+    ////////////////////
+    file.write("NAME {}\n", file_name);
+    if(sense == MAX) file.write("OBJSENSE\n    MAX\n");
+    file.write("ROWS\n N obj\n");
+    for(int row_id = 0; row_id < nb_rows; ++row_id) {
+        if(row_types[row_id] == 'N') continue;
+        file.write(" {} r{}\n", row_types[row_id], row_id);
+    }
+    file.write("COLUMNS\n");
+    bool in_marker = false;
+    int nb_markers = 0;
+    for(int var_id = 0; var_id < nb_vars; ++var_id) {
+        const auto [prefix, index] = names[var_id];
+        if(is_integer[var_id] != in_marker) {
+            file.write("    MARKER{} 'MARKER' '{}'\n", nb_markers++,
+                       in_marker ? "INTEND" : "INTORG");
+            in_marker = is_integer[var_id];
+        }
+        bool empty = true;
+        if(objective[var_id] != 0) {
+            file.write("    {}{} obj {}\n", prefix, index, objective[var_id]);
+            empty = false;
+        }
+        for(CoinBigIndex k = col_starts[var_id]; k < col_starts[var_id + 1];
+            ++k) {
+            if(row_types[col_rows[k]] == 'N') continue;
+            file.write("    {}{} r{} {}\n", prefix, index, col_rows[k],
+                       col_elements[k]);
+            empty = false;
+        }
+        // declares the column
+        if(empty) file.write("    {}{} obj 0\n", prefix, index);
+    }
+    if(in_marker)
+        file.write("    MARKER{} 'MARKER' 'INTEND'\n", nb_markers++);
+    file.write("RHS\n");
+    for(int row_id = 0; row_id < nb_rows; ++row_id) {
+        const double rhs =
+            row_types[row_id] == 'G' ? row_lb[row_id] : row_ub[row_id];
+        if(row_types[row_id] == 'N' || rhs == 0) continue;
+        file.write("    rhs r{} {}\n", row_id, rhs);
+    }
+    file.write("RANGES\n");
+    for(int row_id = 0; row_id < nb_rows; ++row_id) {
+        if(row_types[row_id] != 'L' || is_infinite(row_lb[row_id])) continue;
+        file.write("    rng r{} {}\n", row_id,
+                   row_ub[row_id] - row_lb[row_id]);
+    }
+    file.write("BOUNDS\n");
+    for(int var_id = 0; var_id < nb_vars; ++var_id) {
+        const double lb = col_lb[var_id];
+        const double ub = col_ub[var_id];
+        const auto [prefix, index] = names[var_id];
+        if(lb == ub) {
+            file.write(" FX bnd {}{} {}\n", prefix, index, lb);
+            continue;
+        }
+        if(is_infinite(lb) && is_infinite(ub)) {
+            file.write(" FR bnd {}{}\n", prefix, index);
+            continue;
+        }
+        if(is_infinite(lb))
+            file.write(" MI bnd {}{}\n", prefix, index);
+        else if(lb != 0 || is_integer[var_id])
+            file.write(" LO bnd {}{} {}\n", prefix, index, lb);
+        // the integer columns of the markers may default to binaries
+        if(is_infinite(ub)) {
+            if(is_integer[var_id])
+                file.write(" PL bnd {}{}\n", prefix, index);
+            continue;
+        }
+        file.write(" UP bnd {}{} {}\n", prefix, index, ub);
+    }
+    file.write("ENDATA\n");
+}
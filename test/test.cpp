@@ -2,6 +2,14 @@
 #include <iostream>
 
 #include "algorithms/identify_strong_arcs.h"
+#include "precomputation/compute_strong_and_useless_arcs.hpp"
+#include "precomputation/my_contraction_algorithm.hpp"
+#include "precomputation/options_presolve.hpp"
+#include "precomputation/trivial_reformulation.hpp"
+#include "solvers/pl_eca_2.hpp"
+#include "solvers/pl_eca_3.hpp"
+#include "solvers/warm_start.hpp"
+#include "utils/random_instance_generator.hpp"
 
 int main(int argc, char ** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -99,3 +107,529 @@ GTEST_TEST(IdentifyStrong1, test) {
     EXPECT_EQ(strong_nodes[0], b);
     EXPECT_EQ(strong_nodes[1], c);
 }
+
+GTEST_TEST(PL_ECA_3_Eval, matches_lp) {
+    RandomInstanceGenerator generator;
+    for(int seed = 0; seed < 5; ++seed) {
+        MutableLandscape * landscape =
+            generator.generate_landscape(seed, 30, 50);
+        RestorationPlan<MutableLandscape> * plan =
+            generator.generate_plan(seed, *landscape, 10, true);
+        plan->initElementIDs();
+
+        std::default_random_engine gen(seed);
+        std::bernoulli_distribution coin(0.5);
+        Solution solution(*landscape, *plan);
+        for(const RestorationPlan<MutableLandscape>::Option i :
+            plan->options())
+            if(coin(gen)) solution.add(i);
+        const double B = solution.getCost();
+
+        Solvers::PL_ECA_3 pl_eca_3;
+        const double lp_obj = pl_eca_3.evalLP(*landscape, *plan, B, solution);
+        const double obj = pl_eca_3.eval(*landscape, *plan, B, solution);
+        EXPECT_NEAR(obj, lp_obj, 1e-6 * std::max(1.0, lp_obj));
+
+        delete plan;
+        delete landscape;
+    }
+}
+
+GTEST_TEST(PL_ECA_3_BudgetSweep, matches_solve) {
+    RandomInstanceGenerator generator;
+    for(int seed = 0; seed < 3; ++seed) {
+        MutableLandscape * landscape =
+            generator.generate_landscape(seed, 20, 30);
+        RestorationPlan<MutableLandscape> * plan =
+            generator.generate_plan(seed, *landscape, 8, true);
+        plan->initElementIDs();
+
+        // the second budget exceeds the total cost of the options
+        const double total_cost = plan->totalCost();
+        const std::vector<double> budgets = {2 * total_cost,
+                                             total_cost / 2};
+        Solvers::PL_ECA_3 pl_eca_3;
+        const std::vector<Solution> solutions =
+            pl_eca_3.solveBudgetSweep(*landscape, *plan, budgets);
+        ASSERT_EQ(solutions.size(), budgets.size());
+        for(std::size_t k = 0; k < budgets.size(); ++k) {
+            const Solution solution =
+                pl_eca_3.solve(*landscape, *plan, budgets[k]);
+            EXPECT_LE(solutions[k].getCost(), budgets[k] + 1e-6);
+            EXPECT_NEAR(solutions[k].obj, solution.obj,
+                        1e-6 * std::max(1.0, solution.obj));
+        }
+
+        delete plan;
+        delete landscape;
+    }
+}
+
+GTEST_TEST(PL_ECA_3_SharedIncumbent, optimal_cutoff) {
+    RandomInstanceGenerator generator;
+    for(int seed = 0; seed < 3; ++seed) {
+        MutableLandscape * landscape =
+            generator.generate_landscape(seed, 20, 30);
+        RestorationPlan<MutableLandscape> * plan =
+            generator.generate_plan(seed, *landscape, 8, true);
+        plan->initElementIDs();
+        const double B = plan->totalCost() / 2;
+
+        Solvers::PL_ECA_3 pl_eca_3;
+        const Solution solution = pl_eca_3.solve(*landscape, *plan, B);
+        ASSERT_EQ(solution.status, Solution::OPTIMAL);
+        // nothing improves the optimal incumbent used as cutoff
+        IncumbentStore store;
+        store.publish(solution, ECA().eval(Helper::decore_landscape(
+                                    *landscape, *plan, solution)));
+        pl_eca_3.setIncumbentStore(&store);
+        const Solution shared_solution = pl_eca_3.solve(*landscape, *plan, B);
+        pl_eca_3.setIncumbentStore(nullptr);
+        EXPECT_EQ(shared_solution.status, Solution::OPTIMAL);
+        EXPECT_NEAR(shared_solution.obj, solution.obj,
+                    1e-6 * std::max(1.0, solution.obj));
+        EXPECT_LE(shared_solution.getCost(), B + 1e-6);
+
+        delete plan;
+        delete landscape;
+    }
+}
+
+GTEST_TEST(OptionsPresolve, dominated_options) {
+    MutableLandscape landscape;
+    MutableLandscape::Node u = landscape.addNode(1, Point(0, 0));
+    MutableLandscape::Node v = landscape.addNode(1, Point(1, 0));
+    MutableLandscape::Node w = landscape.addNode(1, Point(2, 0));
+    MutableLandscape::Arc uv = landscape.addArc(u, v, 0.1);
+    MutableLandscape::Arc vw = landscape.addArc(v, w, 0.1);
+
+    RestorationPlan<MutableLandscape> plan(landscape);
+    // i0 restores uv and vw
+    const int i0 = plan.addOption(2);
+    plan.addArc(i0, uv, 0.9);
+    plan.addArc(i0, vw, 0.9);
+    // i1 restores less at a higher cost : dominated
+    const int i1 = plan.addOption(3);
+    plan.addArc(i1, uv, 0.5);
+    // i2 is identical to i0 : dominated
+    const int i2 = plan.addOption(2);
+    plan.addArc(i2, uv, 0.9);
+    plan.addArc(i2, vw, 0.9);
+    // i3 also enhances a node : kept
+    const int i3 = plan.addOption(3);
+    plan.addArc(i3, uv, 0.5);
+    plan.addNode(i3, v, 1);
+    // i4 is over budget
+    const int i4 = plan.addOption(10);
+    plan.addNode(i4, w, 1);
+
+    EXPECT_EQ(remove_over_budget_options(plan, 5), 1);
+    EXPECT_EQ(remove_dominated_options(plan), 2);
+    EXPECT_EQ(plan.getNbOptions(), 5);
+    EXPECT_TRUE(plan.contains(i0, uv));
+    EXPECT_FALSE(plan.contains(i1, uv));
+    EXPECT_FALSE(plan.contains(i2, uv));
+    EXPECT_TRUE(plan.contains(i3, uv));
+    EXPECT_FALSE(plan.contains(i4, w));
+}
+
+GTEST_TEST(PL_ECA_2_WarmStart, null_probability_arc) {
+    MutableLandscape landscape;
+    MutableLandscape::Node s = landscape.addNode(1, Point(0, 0));
+    MutableLandscape::Node v = landscape.addNode(1, Point(1, 0));
+    MutableLandscape::Node t = landscape.addNode(1, Point(2, 0));
+    MutableLandscape::Arc st = landscape.addArc(s, t, 0.5);
+    landscape.addArc(s, v, 0.5);
+    // v only reaches t through an arc that cannot carry flow
+    landscape.addArc(v, t, 0);
+
+    RestorationPlan<MutableLandscape> plan(landscape);
+    const int i = plan.addOption(1);
+    plan.addArc(i, st, 0.9);
+    plan.initElementIDs();
+
+    Solvers::PL_ECA_2 pl_eca_2;
+    pl_eca_2.setWarmStart(Solvers::WarmStart::GLUTTON_ECA_INC);
+    const Solution solution = pl_eca_2.solve(landscape, plan, 1);
+    EXPECT_EQ(solution[i], 1);
+    const double eca =
+        ECA().eval(Helper::decore_landscape(landscape, plan, solution));
+    EXPECT_NEAR(solution.obj, std::pow(eca, 2), 1e-6);
+}
+
+GTEST_TEST(TargetArcs, gather) {
+    using Graph = lemon::ListDigraph;
+    Graph graph;
+    std::vector<Graph::Node> nodes;
+    for(int i = 0; i < 10; ++i) nodes.push_back(graph.addNode());
+    std::vector<Graph::Arc> arcs;
+    for(int i = 0; i < 30; ++i)
+        arcs.push_back(graph.addArc(nodes[i % 10], nodes[(7 * i + 3) % 10]));
+
+    std::default_random_engine gen(0);
+    std::uniform_int_distribution<> node_dis(0, graph.maxNodeId());
+    std::uniform_int_distribution<> arc_dis(0,
+                                            static_cast<int>(arcs.size()) - 1);
+    std::vector<TargetArcs<Graph>::Buffer> buffers(4);
+    for(auto & buffer : buffers)
+        for(int k = 0; k < 100; ++k)
+            buffer.emplace_back(node_dis(gen), arcs[arc_dis(gen)]);
+    // the arcs of a node keep the order of the buffers
+    std::vector<std::vector<Graph::Arc>> expected(graph.maxNodeId() + 1);
+    for(const auto & buffer : buffers)
+        for(const auto & [u_id, a] : buffer) expected[u_id].push_back(a);
+
+    const TargetArcs<Graph> target_arcs(graph.maxNodeId() + 1, buffers);
+    EXPECT_EQ(target_arcs.size(), 400u);
+    for(int u_id = 0; u_id <= graph.maxNodeId(); ++u_id) {
+        const auto row = target_arcs[u_id];
+        EXPECT_TRUE(std::equal(row.begin(), row.end(), expected[u_id].begin(),
+                               expected[u_id].end()));
+    }
+}
+
+// the target-centric strategy labels a subset of the arcs labelled by the
+// arc-centric one, and no arc is both strong and useless
+template <typename TR, typename LEN>
+void expect_consistent_strategies(
+    const lemon::ListDigraph & graph, const LEN & worst_lengths,
+    const LEN & best_lengths,
+    const std::vector<lemon::ListDigraph::Node> & target_nodes) {
+    using Graph = lemon::ListDigraph;
+    const auto [arc_strong, arc_useless] =
+        compute_strong_and_useless_arcs<Graph, LEN, TR>(
+            graph, worst_lengths, best_lengths, target_nodes,
+            StrongUselessStrategy::ARC_CENTRIC);
+    const auto [target_strong, target_useless] =
+        compute_strong_and_useless_arcs<Graph, LEN, TR>(
+            graph, worst_lengths, best_lengths, target_nodes,
+            StrongUselessStrategy::TARGET_CENTRIC);
+    auto contains = [](const auto & arcs, Graph::Arc a) {
+        return std::find(arcs.begin(), arcs.end(), a) != arcs.end();
+    };
+    for(Graph::Node t : target_nodes) {
+        const int t_id = graph.id(t);
+        for(Graph::Arc a : target_strong[t_id]) {
+            EXPECT_TRUE(contains(arc_strong[t_id], a));
+            EXPECT_FALSE(contains(target_useless[t_id], a));
+        }
+        for(Graph::Arc a : target_useless[t_id])
+            EXPECT_TRUE(contains(arc_useless[t_id], a));
+        for(Graph::Arc a : arc_strong[t_id])
+            EXPECT_FALSE(contains(arc_useless[t_id], a));
+    }
+}
+
+GTEST_TEST(StrongUselessArcs, target_centric_within_arc_centric) {
+    using Graph = MutableLandscape::Graph;
+    using LengthMap = Graph::ArcMap<double>;
+    RandomInstanceGenerator generator;
+    for(int seed = 0; seed < 5; ++seed) {
+        MutableLandscape * landscape =
+            generator.generate_landscape(seed, 30, 50);
+        RestorationPlan<MutableLandscape> * plan =
+            generator.generate_plan(seed, *landscape, 20);
+        const Graph & graph = landscape->getNetwork();
+
+        // ties : null cycles and equal parallel arcs
+        std::vector<Graph::Arc> arcs;
+        for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a) arcs.push_back(a);
+        for(std::size_t k = 0; k + 1 < arcs.size(); k += 10) {
+            landscape->setProbability(arcs[k], 1);
+            landscape->setProbability(arcs[k + 1], 1);
+        }
+        for(std::size_t k = 0; k < arcs.size(); k += 4) {
+            const auto elements = (*plan)[arcs[k]];
+            Graph::Arc a = landscape->addArc(
+                graph.source(arcs[k]), graph.target(arcs[k]),
+                landscape->getProbability(arcs[k]));
+            for(const auto & e : elements)
+                plan->addArc(e.option, a, e.restored_probability);
+        }
+
+        LengthMap p_min(graph), p_max(graph);
+        LengthMap worst_lengths(graph), best_lengths(graph);
+        for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a) {
+            p_min[a] = p_max[a] = landscape->getProbability(a);
+            for(const auto & e : (*plan)[a])
+                p_max[a] = std::max(p_max[a], e.restored_probability);
+            worst_lengths[a] = -std::log(p_min[a]);
+            best_lengths[a] = -std::log(p_max[a]);
+        }
+        std::vector<Graph::Node> target_nodes;
+        for(Graph::NodeIt u(graph); u != lemon::INVALID; ++u)
+            if(graph.id(u) % 2 == 0) target_nodes.push_back(u);
+
+        expect_consistent_strategies<
+            lemon::IdentifyMultiplicativeTraits<Graph, LengthMap>>(
+            graph, p_min, p_max, target_nodes);
+        expect_consistent_strategies<
+            lemon::IdentifyDefaultTraits<Graph, LengthMap>>(
+            graph, worst_lengths, best_lengths, target_nodes);
+
+        delete plan;
+        delete landscape;
+    }
+}
+
+GTEST_TEST(StrongUselessArcs, equal_parallel_arcs) {
+    using Graph = lemon::ListDigraph;
+    using LengthMap = Graph::ArcMap<double>;
+    using Traits = lemon::IdentifyMultiplicativeTraits<Graph, LengthMap>;
+    Graph graph;
+    LengthMap p_min(graph), p_max(graph);
+    auto addArc = [&](Graph::Node u, Graph::Node v, double p) {
+        Graph::Arc uv = graph.addArc(u, v);
+        p_min[uv] = p_max[uv] = p;
+        return uv;
+    };
+    Graph::Node s = graph.addNode();
+    Graph::Node u = graph.addNode();
+    Graph::Node v = graph.addNode();
+    Graph::Node t = graph.addNode();
+    Graph::Arc su1 = addArc(s, u, 0.5);
+    Graph::Arc su2 = addArc(s, u, 0.5);
+    Graph::Arc ut1 = addArc(u, t, 0.5);
+    Graph::Arc ut2 = addArc(u, t, 0.5);
+    Graph::Arc uv = addArc(u, v, 0.9);
+    Graph::Arc vt = addArc(v, t, 0.9);
+
+    auto sorted = [](const auto & arcs) {
+        std::vector<Graph::Arc> result(arcs.begin(), arcs.end());
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    const auto [arc_strong, arc_useless] =
+        compute_strong_and_useless_arcs<Graph, LengthMap, Traits>(
+            graph, p_min, p_max, {t}, StrongUselessStrategy::ARC_CENTRIC);
+    const auto [target_strong, target_useless] =
+        compute_strong_and_useless_arcs<Graph, LengthMap, Traits>(
+            graph, p_min, p_max, {t}, StrongUselessStrategy::TARGET_CENTRIC);
+    const int t_id = graph.id(t);
+    // both ties are strong for the arc-centric search
+    EXPECT_EQ(sorted(arc_strong[t_id]), sorted(std::vector{su1, su2, uv, vt}));
+    EXPECT_EQ(sorted(target_strong[t_id]), sorted(std::vector{uv, vt}));
+    EXPECT_EQ(sorted(arc_useless[t_id]), sorted(std::vector{ut1, ut2}));
+    EXPECT_EQ(sorted(target_useless[t_id]), sorted(std::vector{ut1, ut2}));
+}
+
+// adds to a RandomInstanceGenerator instance options restoring an arc with the
+// in-arcs of its source, chains through new relay nodes and equal parallel
+// arcs, one element in four restoring below the probability of its arc
+void add_restoration_patterns(int seed, MutableLandscape & landscape,
+                              RestorationPlan<MutableLandscape> & plan) {
+    using Graph = MutableLandscape::Graph;
+    using Node = MutableLandscape::Node;
+    using Arc = MutableLandscape::Arc;
+    const Graph & graph = landscape.getNetwork();
+    std::default_random_engine gen(seed);
+    std::uniform_real_distribution<> dis(0, 1);
+    auto restored = [&](Arc a) {
+        const double p = landscape.getProbability(a);
+        return dis(gen) < 0.25 ? p / 2 : p + (1 - p) * dis(gen);
+    };
+    std::vector<Node> nodes;
+    for(Graph::NodeIt u(graph); u != lemon::INVALID; ++u) nodes.push_back(u);
+    for(std::size_t k = 0; k < nodes.size(); k += 3)
+        landscape.setQuality(nodes[k], 0);
+    std::vector<Arc> arcs;
+    for(Graph::ArcIt a(graph); a != lemon::INVALID; ++a) arcs.push_back(a);
+    std::uniform_int_distribution<> arc_dis(0,
+                                            static_cast<int>(arcs.size()) - 1);
+
+    for(int k = 0; k < 3; ++k) {
+        const Arc a = arcs[arc_dis(gen)];
+        const Node u = graph.source(a);
+        int option = plan.addOption(1);
+        plan.addArc(option, a, restored(a));
+        for(Graph::InArcIt b(graph, u); b != lemon::INVALID; ++b)
+            plan.addArc(option, b, restored(b));
+        plan.addNode(option, u, 1);
+
+        const Arc b = arcs[arc_dis(gen)];
+        const Node w =
+            landscape.addNode(0, landscape.getCoords(graph.source(b)));
+        const Arc xw = landscape.addArc(graph.source(b), w, dis(gen));
+        const Arc wy = landscape.addArc(w, graph.target(b), dis(gen));
+        option = plan.addOption(1);
+        plan.addArc(option, xw, restored(xw));
+        plan.addArc(option, wy, restored(wy));
+
+        const Arc c = arcs[arc_dis(gen)];
+        const Arc parallel_c = landscape.addArc(
+            graph.source(c), graph.target(c), landscape.getProbability(c));
+        option = plan.addOption(1);
+        plan.addArc(option, parallel_c, restored(parallel_c));
+    }
+}
+
+// sum of the qualities weighted by the best probability to reach t
+template <typename LS>
+double target_value(const LS & landscape, typename LS::Node t) {
+    using Reversed = lemon::ReverseDigraph<const typename LS::Graph>;
+    Reversed reversed_graph(landscape.getNetwork());
+    lemon::MultiplicativeSimplerDijkstra<Reversed, typename LS::ProbabilityMap>
+        dijkstra(reversed_graph, landscape.getProbabilityMap());
+    double sum = 0;
+    dijkstra.init(t);
+    while(!dijkstra.emptyQueue()) {
+        const auto [v, p_vt] = dijkstra.processNextNode();
+        sum += landscape.getQuality(v) * p_vt;
+    }
+    return sum;
+}
+
+// compares, over random option subsets, the value of each target in the
+// landscape with the one in its contracted instance
+void expect_same_target_values(
+    int seed, const MutableLandscape & landscape,
+    const RestorationPlan<MutableLandscape> & plan,
+    const MutableLandscape::Graph::NodeMap<std::shared_ptr<ContractionResult>> &
+        results) {
+    using Graph = MutableLandscape::Graph;
+    const Graph & graph = landscape.getNetwork();
+    const auto compiled_plan = plan.compile();
+    std::default_random_engine gen(seed);
+    std::bernoulli_distribution coin(0.5);
+    for(int k = 0; k < 10; ++k) {
+        std::vector<bool> chosen(plan.getNbOptions());
+        for(std::size_t i = 0; i < chosen.size(); ++i) chosen[i] = coin(gen);
+        DecoredLandscape<MutableLandscape> decored_landscape(landscape);
+        Helper::decore_landscape(decored_landscape, compiled_plan, chosen);
+        for(Graph::NodeIt t(graph); t != lemon::INVALID; ++t) {
+            const ContractionResult & result = *results[t];
+            ASSERT_EQ(result.plan.getNbOptions(), plan.getNbOptions());
+            const auto contracted_plan = result.plan.compile();
+            DecoredLandscape<StaticLandscape> decored_contracted_landscape(
+                result.landscape);
+            Helper::decore_landscape(decored_contracted_landscape,
+                                     contracted_plan, chosen);
+            const double value = target_value(decored_landscape, t);
+            EXPECT_NEAR(target_value(decored_contracted_landscape, result.t),
+                        value, 1e-8 * std::max(1.0, value));
+        }
+    }
+}
+
+GTEST_TEST(MyContractionAlgorithm, preserves_target_values) {
+    RandomInstanceGenerator generator;
+    for(int seed = 0; seed < 5; ++seed) {
+        MutableLandscape * landscape =
+            generator.generate_landscape(seed, 20, 30);
+        RestorationPlan<MutableLandscape> * plan =
+            generator.generate_plan(seed, *landscape, 8, true);
+        add_restoration_patterns(seed, *landscape, *plan);
+
+        MyContractionAlgorithm algo;
+        const auto results = algo.precompute(*landscape, *plan);
+        expect_same_target_values(seed, *landscape, *plan, *results);
+
+        delete plan;
+        delete landscape;
+    }
+}
+
+GTEST_TEST(MyContractionAlgorithm, incremental_precompute) {
+    using Graph = MutableLandscape::Graph;
+    RandomInstanceGenerator generator;
+    for(int seed = 0; seed < 5; ++seed) {
+        MutableLandscape * landscape =
+            generator.generate_landscape(seed, 20, 30);
+        RestorationPlan<MutableLandscape> * plan =
+            generator.generate_plan(seed, *landscape, 8, true);
+        add_restoration_patterns(seed, *landscape, *plan);
+        const Graph & graph = landscape->getNetwork();
+        std::vector<Graph::Node> target_nodes;
+        for(Graph::NodeIt u(graph); u != lemon::INVALID; ++u)
+            target_nodes.push_back(u);
+
+        MyContractionAlgorithm algo;
+        const ContractionInputs inputs(*landscape, *plan);
+        const auto results = algo.precompute(*landscape, *plan, target_nodes);
+        const std::vector<double> costs = inputs.costs;
+
+        // empties options, changes a cost and a quality
+        std::default_random_engine gen(seed);
+        std::bernoulli_distribution coin(0.25);
+        std::vector<bool> removed(plan->getNbOptions());
+        for(std::size_t i = 0; i < removed.size(); ++i) removed[i] = coin(gen);
+        remove_options(*plan, removed);
+        plan->setCost(0, plan->getCost(0) + 1);
+        const Graph::Node u = target_nodes[seed % target_nodes.size()];
+        landscape->setQuality(u, landscape->getQuality(u) + 1);
+
+        const auto incremental_results = algo.precompute(
+            *landscape, *plan, target_nodes, inputs, *results);
+        expect_same_target_values(seed, *landscape, *plan,
+                                  *incremental_results);
+        for(Graph::Node t : target_nodes) {
+            const RestorationPlan<StaticLandscape> & previous_plan =
+                (*results)[t]->plan;
+            for(const RestorationPlan<StaticLandscape>::Option i :
+                previous_plan.options()) {
+                EXPECT_EQ(previous_plan.getCost(i), costs[i]);
+                EXPECT_EQ((*incremental_results)[t]->plan.getCost(i),
+                          plan->getCost(i));
+            }
+        }
+
+        delete plan;
+        delete landscape;
+    }
+}
+
+// ECA of the landscape restored by the options i such that chosen[i]
+template <typename LS>
+double restored_eca(const LS & landscape, const RestorationPlan<LS> & plan,
+                    const std::vector<bool> & chosen) {
+    DecoredLandscape<LS> decored_landscape(landscape);
+    Helper::decore_landscape(decored_landscape, plan.compile(), chosen);
+    return ECA().eval(decored_landscape);
+}
+
+// compares, over random option subsets, the ECA of random instances with the
+// one of their copies simplified by reduce, that must keep the options
+template <typename Reduction>
+void expect_same_restored_eca(Reduction && reduce) {
+    RandomInstanceGenerator generator;
+    for(int seed = 0; seed < 5; ++seed) {
+        MutableLandscape * landscape =
+            generator.generate_landscape(seed, 20, 30);
+        RestorationPlan<MutableLandscape> * plan =
+            generator.generate_plan(seed, *landscape, 8, true);
+        add_restoration_patterns(seed, *landscape, *plan);
+        Instance reduced = copy_and_compact_instance(*landscape, *plan);
+        ASSERT_EQ(reduced.plan.getNbOptions(), plan->getNbOptions());
+        reduce(reduced.landscape, reduced.plan);
+
+        std::default_random_engine gen(seed);
+        std::bernoulli_distribution coin(0.5);
+        for(int k = 0; k < 20; ++k) {
+            std::vector<bool> chosen(plan->getNbOptions());
+            for(std::size_t i = 0; i < chosen.size(); ++i)
+                chosen[i] = coin(gen);
+            const double eca = restored_eca(*landscape, *plan, chosen);
+            EXPECT_NEAR(restored_eca(reduced.landscape, reduced.plan, chosen),
+                        eca, 1e-8 * std::max(1.0, eca));
+        }
+
+        delete plan;
+        delete landscape;
+    }
+}
+
+GTEST_TEST(TrivialReformulation, contract_series_nodes) {
+    expect_same_restored_eca(contract_series_nodes);
+}
+
+GTEST_TEST(TrivialReformulation, remove_dominated_arcs) {
+    expect_same_restored_eca([](MutableLandscape & landscape,
+                                RestorationPlan<MutableLandscape> & plan) {
+        remove_dominated_arcs(landscape, plan);
+        remove_dead_end_nodes(landscape, plan);
+    });
+    expect_same_restored_eca([](MutableLandscape & landscape,
+                                RestorationPlan<MutableLandscape> & plan) {
+        remove_dominated_arcs(landscape, plan, 1);
+    });
+}